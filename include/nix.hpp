@@ -10,11 +10,22 @@
 
 #include <nix/Platform.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/ChunkCache.hpp>
+#include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Block.hpp>
 #include <nix/DataArray.hpp>
+#include <nix/DataAppender.hpp>
+#include <nix/DataSegments.hpp>
+#include <nix/DataStream.hpp>
+#include <nix/AsyncAppender.hpp>
 #include <nix/MultiTag.hpp>
+#include <nix/SegmentReducer.hpp>
 #include <nix/Dimensions.hpp>
+#include <nix/DimensionMapper.hpp>
 #include <nix/File.hpp>
+#include <nix/MetadataTree.hpp>
 #include <nix/Property.hpp>
 #include <nix/Feature.hpp>
 #include <nix/Section.hpp>
@@ -0,0 +1,167 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ASYNC_APPENDER_H
+#define NIX_ASYNC_APPENDER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Appends data to a {@link nix::DataArray} from a background thread.
+ *
+ * Blocks passed to {@link append} are copied into a bounded single
+ * producer / single consumer ring buffer. A dedicated writer thread takes
+ * them out and appends them with DataArray::appendData. The writer thread
+ * makes all HDF5 calls; since the HDF5 library is not thread-safe the file
+ * must not be used by any other thread until the appender is closed.
+ * append() must always be called from the same thread.
+ *
+ * What happens if the ring buffer is full is controlled by the
+ * {@link Backpressure} policy.
+ */
+class NIXAPI AsyncAppender {
+
+public:
+
+    /**
+     * @brief Behaviour of append() if the ring buffer is full.
+     */
+    enum class Backpressure {
+        Block,  //!< wait until the writer has made room
+        Drop,   //!< discard the block, append() returns false
+        Spill   //!< store the block in a temporary file
+    };
+
+    /**
+     * @brief Number of buckets of the latency histogram.
+     */
+    static const size_t LATENCY_BUCKETS = 32;
+
+    /**
+     * @brief Counters of the appender.
+     *
+     * Bucket i of latency counts the blocks that were written between
+     * 2^i and 2^(i+1) microseconds after they had been appended.
+     */
+    struct Stats {
+        size_t enqueued = 0;
+        size_t written = 0;
+        size_t dropped = 0;
+        size_t spilled = 0;
+        std::array<size_t, LATENCY_BUCKETS> latency{};
+    };
+
+    /**
+     * @brief Create the appender and start the writer thread.
+     *
+     * @param array     The DataArray to append to; it must already hold data.
+     * @param axis      The axis along which data is appended.
+     * @param capacity  The number of blocks the ring buffer can hold.
+     * @param policy    What to do if the ring buffer is full.
+     */
+    AsyncAppender(const DataArray &array, size_t axis, size_t capacity = 64,
+                  Backpressure policy = Backpressure::Block);
+
+    AsyncAppender(const AsyncAppender &other) = delete;
+
+    AsyncAppender &operator=(const AsyncAppender &other) = delete;
+
+    /**
+     * @brief Queue a block of data for appending.
+     *
+     * @param dtype     The type of the data.
+     * @param data      Pointer to the data; it is copied.
+     * @param count     The shape of the block.
+     *
+     * @return False if the block was dropped, true otherwise.
+     */
+    bool append(DataType dtype, const void *data, const NDSize &count);
+
+    /**
+     * @brief Wait until all blocks appended so far have been written.
+     *
+     * Errors of the writer thread are rethrown here.
+     */
+    void flush();
+
+    /**
+     * @brief Flush and stop the writer thread.
+     */
+    void close();
+
+
+    Stats stats() const;
+
+
+    ~AsyncAppender();
+
+private:
+
+    struct Block {
+        DataType                                       dtype;
+        NDSize                                         count;
+        std::vector<char>                              data;
+        std::chrono::steady_clock::time_point          queued;
+    };
+
+    void run();
+
+    bool spill(const Block &block);
+
+    bool unspill(Block &block);
+
+    void write(const Block &block);
+
+    void rethrow() const;
+
+    DataArray                       array;
+    size_t                          axis;
+    Backpressure                    policy;
+
+    std::vector<Block>              ring;
+    std::atomic<size_t>             head;       // next slot to be written, owned by the writer
+    std::atomic<size_t>             tail;       // next free slot, owned by the producer
+
+    std::mutex                      spill_mutex;
+    std::FILE                      *spill_file;
+    long                            spill_read;
+    long                            spill_write;
+    std::atomic<bool>               spilling;
+
+    std::mutex                      wait_mutex;
+    std::condition_variable         wake_writer;
+    std::condition_variable         wake_producer;
+
+    std::atomic<size_t>             enqueued;
+    std::atomic<size_t>             written;
+    std::atomic<size_t>             dropped;
+    std::atomic<size_t>             spilled;
+    std::array<std::atomic<size_t>, LATENCY_BUCKETS> latency;
+
+    std::atomic<bool>               stop;
+    std::exception_ptr              error;
+    std::atomic<bool>               failed;
+    std::thread                     writer;
+};
+
+} // namespace nix
+
+#endif // NIX_ASYNC_APPENDER_H
@@ -15,6 +15,7 @@
 #include <nix/DataArray.hpp>
 #include <nix/MultiTag.hpp>
 #include <nix/Tag.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 
 #include <string>
@@ -200,6 +201,18 @@ public:
      */
     std::vector<Source> sources(const util::Filter<Source>::type &filter = util::AcceptAll<Source>()) const;
 
+    /**
+     * @brief Lazily iterate over the sources of this block.
+     *
+     * Unlike {@link sources} the sources are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered sources.
+     */
+    EntityRange<Source> sourceRange(const util::Filter<Source>::type &filter = util::AcceptAll<Source>()) const;
+
     /**
      * @brief Get all sources in this block recursively.
      *
@@ -313,6 +326,18 @@ public:
     std::vector<DataArray> dataArrays(const util::AcceptAll<DataArray>::type &filter
                                       = util::AcceptAll<DataArray>()) const;
 
+    /**
+     * @brief Lazily iterate over the data arrays of this block.
+     *
+     * Unlike {@link dataArrays} the data arrays are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered data arrays.
+     */
+    EntityRange<DataArray> dataArrayRange(const util::Filter<DataArray>::type &filter = util::AcceptAll<DataArray>()) const;
+
     /**
      * @brief Returns the number of all data arrays of the block.
      *
@@ -329,13 +354,18 @@ public:
     * @param type      The type of the data array.
     * @param data_type A nix::DataType indicating the format to store values.
     * @param shape     A NDSize holding the extent of the array to create.
+    * @param compression The filters (e.g. deflate, shuffle) to apply to the data.
+    * @param chunking  Hints on how the data is accessed, used to choose the
+    *                  chunk shape (see nix::Chunking).
     *
     * @return The newly created data array.
     */
     DataArray createDataArray(const std::string &name,
                               const std::string &type,
                               nix::DataType      data_type,
-                              const NDSize      &shape);
+                              const NDSize      &shape,
+                              const Compression &compression = Compression(),
+                              const Chunking    &chunking = Chunking());
 
     /**
     * @brief Create a new data array associated with this block.
@@ -344,6 +374,8 @@ public:
     * @param type      The type of the data array.
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
+    * @param compression The filters (e.g. deflate, shuffle) to apply to the data.
+    * @param chunking  Hints on how the data is accessed (see nix::Chunking).
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -356,7 +388,9 @@ public:
     DataArray createDataArray(const std::string &name,
                               const std::string &type,
                               const T &data,
-                              DataType data_type = DataType::Nothing) {
+                              DataType data_type = DataType::Nothing,
+                              const Compression &compression = Compression(),
+                              const Chunking &chunking = Chunking()) {
          const Hydra<const T> hydra(data);
 
          if (data_type == DataType::Nothing) {
@@ -364,7 +398,7 @@ public:
          }
 
          const NDSize shape = hydra.shape();
-         DataArray da = createDataArray(name, type, data_type, shape);
+         DataArray da = createDataArray(name, type, data_type, shape, compression, chunking);
 
          const NDSize offset(shape.size(), 0);
          da.setData(data, offset);
@@ -458,6 +492,18 @@ public:
     std::vector<Tag> tags(const util::Filter<Tag>::type &filter
                           = util::AcceptAll<Tag>()) const;
 
+    /**
+     * @brief Lazily iterate over the tags of this block.
+     *
+     * Unlike {@link tags} the tags are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered tags.
+     */
+    EntityRange<Tag> tagRange(const util::Filter<Tag>::type &filter = util::AcceptAll<Tag>()) const;
+
     /**
      * @brief Returns the number of tags within this block.
      *
@@ -565,6 +611,18 @@ public:
     std::vector<MultiTag> multiTags(const util::AcceptAll<MultiTag>::type &filter
                                   = util::AcceptAll<MultiTag>()) const;
 
+    /**
+     * @brief Lazily iterate over the multi tags of this block.
+     *
+     * Unlike {@link multiTags} the multi tags are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered multi tags.
+     */
+    EntityRange<MultiTag> multiTagRange(const util::Filter<MultiTag>::type &filter = util::AcceptAll<MultiTag>()) const;
+
     /**
      * @brief Returns the number of multi tags associated with this block.
      *
@@ -0,0 +1,63 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNK_CACHE_H
+#define NIX_CHUNK_CACHE_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+
+#include <cstddef>
+
+namespace nix {
+
+/**
+ * @brief Settings of the cache that holds chunks of chunked data in memory.
+ *
+ * The default values are the defaults of the HDF5 library. The settings
+ * can be applied to all data of a file via {@link nix::File::open} or to a
+ * single {@link nix::DataArray}.
+ */
+struct NIXAPI ChunkCache {
+
+    /**
+     * @brief Number of hash table slots; should be a prime number
+     *        about 100 times the number of chunks that fit into the cache.
+     */
+    size_t slots = 521;
+
+    /**
+     * @brief Size of the cache in bytes.
+     */
+    size_t bytes = 1024 * 1024;
+
+    /**
+     * @brief Preemption policy between 0 and 1; 1 evicts chunks that were
+     *        fully read or written first.
+     */
+    double preemption = 0.75;
+
+    /**
+     * @brief Derives cache settings from the chunk shape and the access pattern.
+     *
+     * The cache is sized so that all chunks touched by one access of shape
+     * access (at an arbitrary offset) fit into it, which avoids that the same
+     * chunk is read and decompressed again by the next, neighbouring access.
+     *
+     * @param chunks        The chunk shape of the data.
+     * @param element_size  The size of a single element in bytes.
+     * @param access        The shape of a typical read or write.
+     *
+     * @return The cache settings; the defaults if the data is not chunked.
+     */
+    static ChunkCache forAccess(const NDSize &chunks, size_t element_size, const NDSize &access);
+};
+
+} // namespace nix
+
+#endif // NIX_CHUNK_CACHE_H
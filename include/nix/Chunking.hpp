@@ -0,0 +1,107 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNKING_H
+#define NIX_CHUNKING_H
+
+#include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+
+namespace nix {
+
+/**
+ * @brief Describes how the data of a {@link nix::DataArray} will be used,
+ *        so that a suitable chunk shape can be chosen when it is created.
+ *
+ * Without any hint the back-end guesses the chunk shape from the extent
+ * alone. For a time x channel array that grows along the time axis and is
+ * read channel by channel one would use:
+ *
+ * ~~~
+ * Chunking chunking = Chunking::growingAlong(0);
+ * chunking.read_axis = 0;
+ * DataArray da = b.createDataArray("raw", "ephys", DataType::Int16, {0, 64},
+ *                                  Compression(), chunking);
+ * ~~~
+ */
+struct NIXAPI Chunking {
+
+    /**
+     * @brief The axis along which data is appended.
+     */
+    boost::optional<size_t> growth_axis;
+
+    /**
+     * @brief The axis along which data is read contiguously, e.g. the time
+     *        axis if single channels are read. The other axes are kept as
+     *        narrow as possible so that reads are chunk-aligned.
+     *
+     * Appends then touch one chunk per position on the other axes, so the
+     * chunk cache should be sized to hold them (see DataArray::chunkCacheFor).
+     */
+    boost::optional<size_t> read_axis;
+
+    /**
+     * @brief The shape of a typical read or write; overrides read_axis.
+     */
+    NDSize access;
+
+    /**
+     * @brief An explicit chunk shape; overrides all other settings.
+     */
+    NDSize chunks;
+
+    /**
+     * @brief The size of a chunk in bytes the policy aims for.
+     */
+    size_t target_bytes = 64 * 1024;
+
+    /**
+     * @brief Check if any hint was given.
+     */
+    bool hasHints() const {
+        return growth_axis || read_axis || access.size() > 0 || chunks.size() > 0;
+    }
+
+    /**
+     * @brief Chunking for data that is appended along the given axis.
+     */
+    static Chunking growingAlong(size_t axis) {
+        Chunking c;
+        c.growth_axis = axis;
+        return c;
+    }
+
+    /**
+     * @brief Chunking for a typical access of the given shape.
+     */
+    static Chunking forAccess(const NDSize &access) {
+        Chunking c;
+        c.access = access;
+        return c;
+    }
+
+    /**
+     * @brief Compute the chunk shape for data of the given shape.
+     *
+     * @param shape         The initial extent of the data; zero for
+     *                      axes that grow.
+     * @param element_size  The size of a single element in bytes.
+     *
+     * @return The chunk shape; empty if no hint was given.
+     */
+    NDSize chunkShape(const NDSize &shape, size_t element_size) const;
+};
+
+} // namespace nix
+
+#endif // NIX_CHUNKING_H
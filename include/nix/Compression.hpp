@@ -0,0 +1,80 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COMPRESSION_H
+#define NIX_COMPRESSION_H
+
+#include <nix/Platform.hpp>
+
+namespace nix {
+
+/**
+ * @brief Filters applied to the data of a {@link nix::DataArray}.
+ *
+ * The filters are set when the data is created and can not be changed
+ * afterwards. By default no filter is used.
+ *
+ * ~~~
+ * Block b = ...;
+ * DataArray da = b.createDataArray("raw", "ephys", DataType::Int16, {0},
+ *                                  Compression::deflateWith(4, true));
+ * ~~~
+ */
+struct NIXAPI Compression {
+
+    /**
+     * @brief Deflate (gzip) level between 0 and 9; negative disables deflate.
+     */
+    int deflate = -1;
+
+    /**
+     * @brief Reorder the bytes of the elements before compressing them.
+     */
+    bool shuffle = false;
+
+    /**
+     * @brief Store a Fletcher32 checksum for every chunk.
+     */
+    bool fletcher32 = false;
+
+    /**
+     * @brief Check if any filter is enabled.
+     */
+    bool enabled() const {
+        return deflate >= 0 || shuffle || fletcher32;
+    }
+
+    /**
+     * @brief Settings for deflate compression, optionally with shuffle.
+     *
+     * @param level     The deflate level (0-9).
+     * @param shuffle   Enable the shuffle filter.
+     *
+     * @return The compression settings.
+     */
+    static Compression deflateWith(int level = 6, bool shuffle = true) {
+        Compression c;
+        c.deflate = level;
+        c.shuffle = shuffle;
+        return c;
+    }
+};
+
+
+inline bool operator==(const Compression &lhs, const Compression &rhs) {
+    return lhs.deflate == rhs.deflate && lhs.shuffle == rhs.shuffle && lhs.fletcher32 == rhs.fletcher32;
+}
+
+
+inline bool operator!=(const Compression &lhs, const Compression &rhs) {
+    return !(lhs == rhs);
+}
+
+} // namespace nix
+
+#endif // NIX_COMPRESSION_H
@@ -0,0 +1,124 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_APPENDER_H
+#define NIX_DATA_APPENDER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/Hydra.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Buffered, append only writer for the data of a {@link nix::DataArray}.
+ *
+ * Appended blocks are collected in memory and written in one go once the
+ * buffer is full. The extent of the data is grown geometrically (and in
+ * whole chunks) instead of for every block; it is trimmed to the actual
+ * amount of data by {@link close}, which is also called by the destructor.
+ * Until then the DataArray may report a larger extent than was appended.
+ *
+ * ~~~
+ * DataArray da = b.createDataArray("raw", "ephys", DataType::Int16, {0, 64});
+ * DataAppender app = da.appender(0);
+ * while (acquiring) {
+ *     app.append(DataType::Int16, samples, {n, 64});
+ * }
+ * app.close();
+ * ~~~
+ */
+class NIXAPI DataAppender {
+
+public:
+
+    /**
+     * @brief Create an appender for a DataArray.
+     *
+     * @param array         The DataArray to append to; it must already hold data.
+     * @param axis          The axis along which data is appended.
+     * @param buffer_bytes  The size of the write buffer in bytes. It is
+     *                      rounded down to whole chunks along the axis,
+     *                      but the buffer holds at least one chunk, so a
+     *                      small size is in effect rounded up.
+     */
+    DataAppender(const DataArray &array, size_t axis, size_t buffer_bytes = 4 * 1024 * 1024);
+
+    DataAppender(const DataAppender &other) = delete;
+
+    DataAppender(DataAppender &&other);
+
+    DataAppender &operator=(const DataAppender &other) = delete;
+
+    /**
+     * @brief Append a block of data.
+     *
+     * @param dtype     The type of the data; must be the same for all blocks.
+     * @param data      Pointer to the data.
+     * @param count     The shape of the block; must match the DataArray in
+     *                  all dimensions but the append axis.
+     */
+    void append(DataType dtype, const void *data, const NDSize &count);
+
+    /**
+     * @brief Append a block of data from any type supported by {@link nix::Hydra}.
+     */
+    template<typename T>
+    void append(const T &value) {
+        const Hydra<const T> hydra(value);
+        append(hydra.element_data_type(), hydra.data(), hydra.shape());
+    }
+
+    /**
+     * @brief Write all buffered data to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Flush the buffer and trim the extent to the appended data.
+     */
+    void close();
+
+    /**
+     * @brief The length of the data along the append axis, including
+     *        the data that is still buffered.
+     */
+    ndsize_t size() const {
+        return written + buffered;
+    }
+
+
+    ~DataAppender();
+
+private:
+
+    void write(const char *data, const NDSize &count, ndsize_t rows);
+
+    void reserve(ndsize_t rows);
+
+    DataArray         array;
+    size_t            axis;
+    DataType          dtype;
+    size_t            buffer_size;
+    NDSize            shape;       // extent with the append axis set to 1
+    ndsize_t          outer;       // product of the dimensions before the axis
+    size_t            row_bytes;   // bytes per outer index and step along the axis
+    ndsize_t          chunk_rows;
+    ndsize_t          capacity;    // rows the buffer can hold
+    ndsize_t          buffered;
+    ndsize_t          written;
+    ndsize_t          allocated;   // current extent along the axis
+    std::vector<char> buffer;
+    bool              open;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_APPENDER_H
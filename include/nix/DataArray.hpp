@@ -18,9 +18,15 @@
 
 #include <nix/Platform.hpp>
 
+#include <functional>
 
 namespace nix {
 
+class DataAppender;
+class Tag;
+class MultiTag;
+class Feature;
+
 // TODO add documentation for undocumented methods.
 
 /**
@@ -424,6 +430,23 @@ public:
         backend()->read(dtype, data, count, offset);
     }
 
+    /**
+     * @brief Read several slices of the data at once.
+     *
+     * The slices are stored back to back in data, in the requested order,
+     * with the polynomial and expansion origin applied. Slices that do not
+     * overlap in the file are read with a single I/O operation.
+     *
+     * @param dtype     The type of the data buffer.
+     * @param data      Buffer for the sum of all counts elements.
+     * @param offsets   The position where each slice starts.
+     * @param counts    The size of each slice.
+     */
+    void getDataSegments(DataType dtype,
+                         void *data,
+                         const std::vector<NDSize> &offsets,
+                         const std::vector<NDSize> &counts) const;
+
     void setDataDirect(DataType dtype,
                        const void *data,
                        const NDSize &count,
@@ -462,6 +485,109 @@ public:
 
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
+    /**
+     * @brief Create a buffered appender for this DataArray.
+     *
+     * Use this instead of appendData() to append many small blocks.
+     * Requires nix/DataAppender.hpp.
+     *
+     * @param axis          The axis along which data is appended.
+     * @param buffer_bytes  The size of the write buffer in bytes; rounded
+     *                      to whole chunks, see nix::DataAppender.
+     *
+     * @return The appender.
+     */
+    DataAppender appender(size_t axis, size_t buffer_bytes = 4 * 1024 * 1024);
+
+    /**
+     * @brief Get the filters the data was created with.
+     *
+     * @return The active filters.
+     */
+    Compression compression() const {
+        return backend()->compression();
+    }
+
+    /**
+     * @brief Get the chunk shape of the stored data.
+     *
+     * @return The chunk shape or an empty NDSize if the data is not chunked.
+     */
+    NDSize dataChunks() const {
+        return backend()->dataChunks();
+    }
+
+    /**
+     * @brief Get the chunk cache settings used to access the data.
+     *
+     * @return The chunk cache settings.
+     */
+    ChunkCache chunkCache() const {
+        return backend()->chunkCache();
+    }
+
+    /**
+     * @brief Set the chunk cache settings used to access the data.
+     *
+     * The settings apply to this DataArray object only and override the
+     * settings given to {@link nix::File::open}.
+     *
+     * @param cache     The chunk cache settings.
+     */
+    void chunkCache(const ChunkCache &cache) {
+        backend()->chunkCache(cache);
+    }
+
+    /**
+     * @brief Size the chunk cache for a given access pattern.
+     *
+     * Uses {@link nix::ChunkCache::forAccess} with the chunk shape and
+     * the data type of the stored data.
+     *
+     * @param access    The shape of a typical read or write, e.g. {n, 1}
+     *                  to read single columns out of a 2-D array.
+     */
+    void chunkCacheFor(const NDSize &access);
+
+    //--------------------------------------------------
+    // Methods concerning entities that refer to the data array
+    //--------------------------------------------------
+
+    /**
+     * @brief Get the tags that refer to this data array.
+     *
+     * These are the tags of the block that have the data array among
+     * their references or as the data of one of their features. The
+     * links of all tags of a block are indexed when this or one of the
+     * related methods is called for the first time, so that later calls
+     * do not depend on the number of tags in the block.
+     *
+     * @param filter    A filter function.
+     *
+     * @return The tags that refer to the data array.
+     */
+    std::vector<Tag> referringTags(const util::Filter<Tag>::type &filter = util::AcceptAll<Tag>()) const;
+
+    /**
+     * @brief Get the multi-tags that refer to this data array.
+     *
+     * Like {@link referringTags}, but for multi-tags, which may also use the
+     * data array as their positions or extents.
+     *
+     * @param filter    A filter function.
+     *
+     * @return The multi-tags that refer to the data array.
+     */
+    std::vector<MultiTag> referringMultiTags(const util::Filter<MultiTag>::type &filter = util::AcceptAll<MultiTag>()) const;
+
+    /**
+     * @brief Get the features of tags and multi-tags that have this data
+     *        array as their data.
+     *
+     * @return The features that refer to the data array.
+     */
+    std::vector<Feature> referringFeatures() const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -491,6 +617,11 @@ protected:
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset);
+
+private:
+    // reads count elements via reader and applies polynomial and origin
+    void readCalibrated(DataType dtype, void *data, ndsize_t count,
+                        const std::function<void(DataType, void *)> &reader) const;
 };
 
 } // namespace nix
@@ -0,0 +1,82 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_SEGMENTS_H
+#define NIX_DATA_SEGMENTS_H
+
+#include <nix/NDArray.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Data slices of a {@link nix::DataArray} stored back to back.
+ *
+ * Slice i has the shape counts[i], starts at offsets[i] in the DataArray
+ * and occupies the elements starts[i] to starts[i + 1] of data. The
+ * elements of a slice are stored in row-major order.
+ *
+ * ~~~
+ * DataSegments segs = mtag.retrieveDataBatch(indices, 0);
+ * for (size_t i = 0; i < segs.size(); i++) {
+ *     const double *slice = segs.segment<double>(i);
+ *     ...
+ * }
+ * ~~~
+ */
+struct NIXAPI DataSegments {
+
+    /**
+     * @brief The data of all slices, as a one dimensional array.
+     */
+    NDArray data;
+
+    /**
+     * @brief The offset of every slice in the DataArray.
+     */
+    std::vector<NDSize> offsets;
+
+    /**
+     * @brief The shape of every slice.
+     */
+    std::vector<NDSize> counts;
+
+    /**
+     * @brief The index of the first element of every slice in data, plus
+     *        the total number of elements.
+     */
+    std::vector<ndsize_t> starts;
+
+
+    DataSegments(DataType dtype)
+        : data(dtype, NDSize{0}), starts(1, 0)
+    {}
+
+    /**
+     * @brief The number of slices.
+     */
+    size_t size() const {
+        return counts.size();
+    }
+
+    /**
+     * @brief Pointer to the first element of slice i; T must match the
+     *        data type of data.
+     */
+    template<typename T>
+    const T *segment(size_t i) const {
+        return reinterpret_cast<const T *>(data.data()) + starts[i];
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_SEGMENTS_H
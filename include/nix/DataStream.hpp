@@ -0,0 +1,232 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_STREAM_H
+#define NIX_DATA_STREAM_H
+
+#include <nix/DataArray.hpp>
+#include <nix/DataView.hpp>
+#include <nix/Platform.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Reads a {@link nix::DataArray} or a {@link nix::DataView} block
+ *        by block, with bounded memory.
+ *
+ * The blocks are aligned to the chunks of the data set: every block
+ * consists of whole chunks, except at the borders of the streamed region,
+ * and is grown along the fastest varying dimensions first until it holds
+ * about block_bytes. Blocks are returned in row-major order of their
+ * offsets. Their data is read with the polynomial and expansion origin of
+ * the DataArray applied.
+ *
+ * With read-ahead, a helper thread reads the next blocks while the current
+ * one is processed; it makes all HDF5 calls, so the file must not be used
+ * by any other thread, including the calling one, while the stream is open.
+ * The memory used is (read_ahead + 1) buffers of the largest block.
+ *
+ * ~~~
+ * DataStream stream(array, DataType::Double);
+ * for (const DataStream::Block &block : stream) {
+ *     const double *x = block.data<double>();
+ *     // block.count elements, at block.offset of the region
+ * }
+ * ~~~
+ */
+class NIXAPI DataStream {
+
+public:
+
+    /**
+     * @brief A block of the streamed region.
+     *
+     * The data is valid until the next block is requested.
+     */
+    struct Block {
+        NDSize      offset;     //!< offset of the block in the streamed region
+        NDSize      count;      //!< shape of the block
+        DataType    dtype;
+        const void *buffer;     //!< the elements in row-major order
+
+        /**
+         * @brief The elements of the block; T must match dtype.
+         */
+        template<typename T>
+        const T *data() const {
+            if (to_data_type<T>::value != dtype) {
+                throw std::invalid_argument("DataStream::Block: type does not match the data type of the stream");
+            }
+            return static_cast<const T *>(buffer);
+        }
+
+        /**
+         * @brief The number of elements of the block.
+         */
+        ndsize_t size() const {
+            return count.nelms();
+        }
+    };
+
+    /**
+     * @brief Input iterator over the remaining blocks of a stream.
+     */
+    class NIXAPI iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Block                   value_type;
+        typedef std::ptrdiff_t          difference_type;
+        typedef const Block            *pointer;
+        typedef const Block            &reference;
+
+        explicit iterator(DataStream *stream = nullptr)
+            : stream(stream)
+        {}
+
+        const Block &operator*() const {
+            return stream->block();
+        }
+
+        const Block *operator->() const {
+            return &stream->block();
+        }
+
+        iterator &operator++() {
+            if (!stream->next()) {
+                stream = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return stream == other.stream;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return stream != other.stream;
+        }
+
+    private:
+        DataStream *stream;
+    };
+
+    /**
+     * @brief Stream all data of a DataArray.
+     *
+     * @param array         The DataArray.
+     * @param dtype         The type the data is read as.
+     * @param read_ahead    The number of blocks read in advance; 0 reads
+     *                      the blocks in the calling thread.
+     * @param block_bytes   The approximate size of a block.
+     */
+    DataStream(const DataArray &array, DataType dtype, size_t read_ahead = 1,
+               size_t block_bytes = 4 * 1024 * 1024);
+
+    /**
+     * @brief Stream the data of a DataView.
+     *
+     * The offsets of the blocks are relative to the view.
+     */
+    DataStream(const DataView &view, DataType dtype, size_t read_ahead = 1,
+               size_t block_bytes = 4 * 1024 * 1024);
+
+    DataStream(const DataStream &other) = delete;
+
+    DataStream &operator=(const DataStream &other) = delete;
+
+    /**
+     * @brief The shape of the blocks; blocks at the borders of the region
+     *        may be smaller.
+     */
+    NDSize blockShape() const {
+        return shape;
+    }
+
+    /**
+     * @brief The number of blocks of the stream.
+     */
+    size_t blockCount() const {
+        return nblocks;
+    }
+
+    /**
+     * @brief Advance to the next block.
+     *
+     * Errors of the read-ahead thread are rethrown here.
+     *
+     * @return False if there are no more blocks.
+     */
+    bool next();
+
+    /**
+     * @brief The current block; only valid after next() returned true.
+     */
+    const Block &block() const {
+        return current;
+    }
+
+    /**
+     * @brief Advances to the first block and returns an iterator to it.
+     */
+    iterator begin();
+
+
+    iterator end() {
+        return iterator();
+    }
+
+
+    ~DataStream();
+
+private:
+
+    void init(size_t read_ahead, size_t block_bytes);
+
+    void blockAt(size_t index, NDSize &block_offset, NDSize &block_count) const;
+
+    void read(size_t index, std::vector<char> &buffer);
+
+    void run();
+
+    DataArray                       array;
+    DataType                        dtype;
+    NDSize                          offset;     // of the region in the DataArray
+    NDSize                          count;      // of the region
+
+    NDSize                          shape;
+    std::vector<std::vector<ndsize_t>> tiles;   // start of the blocks along every dimension, in the region
+    size_t                          nblocks;
+    size_t                          position;   // next block to be returned
+
+    std::vector<std::vector<char>>  pool;
+    std::vector<size_t>             free_buffers;
+    std::deque<std::pair<size_t, size_t>> ready;    // block index, buffer
+    size_t                          current_buffer;
+    Block                           current;
+
+    std::mutex                      mutex;
+    std::condition_variable         filled;
+    std::condition_variable         drained;
+    bool                            stop;
+    std::exception_ptr              error;
+    std::thread                     reader;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_STREAM_H
@@ -16,6 +16,8 @@
 namespace nix {
 
 class NIXAPI DataView : public DataSet {
+    friend class DataStream;
+
 public:
     DataView(DataArray da, NDSize count, NDSize offset)
             : array(std::move(da)), offset(std::move(offset)), count(std::move(count)) {
@@ -0,0 +1,100 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DIMENSION_MAPPER_H
+#define NIX_DIMENSION_MAPPER_H
+
+#include <nix/Dimensions.hpp>
+#include <nix/Platform.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Converts between positions and indices of a dimension.
+ *
+ * The scaling between the unit of the positions and the unit of the
+ * dimension, the offset and sampling interval of a sampled dimension and the
+ * number of labels of a set dimension are read once, when the mapper is
+ * created; later changes are not seen by the mapper. Range dimensions use
+ * the ticks cached by the dimension itself.
+ *
+ * ~~~
+ * DimensionMapper time(array.getDimension(1), "s");
+ * std::vector<size_t> indices = time.indexOf(spike_times);
+ * ~~~
+ */
+class NIXAPI DimensionMapper {
+
+public:
+
+    /**
+     * @brief Create a mapper for a dimension.
+     *
+     * @param dimension     The dimension.
+     * @param unit          The unit of the positions; "none" if they are
+     *                      given in the unit of the dimension.
+     */
+    explicit DimensionMapper(const Dimension &dimension, const std::string &unit = "none");
+
+    /**
+     * @brief The type of the mapped dimension.
+     */
+    DimensionType dimensionType() const {
+        return type;
+    }
+
+    /**
+     * @brief The index of a position; same as util::positionToIndex.
+     */
+    size_t indexOf(double position) const;
+
+    /**
+     * @brief The indices of count positions.
+     *
+     * @param positions     The positions.
+     * @param count         The number of positions.
+     * @param[out] indices  Buffer for count indices.
+     */
+    void indexOf(const double *positions, size_t count, size_t *indices) const;
+
+
+    std::vector<size_t> indexOf(const std::vector<double> &positions) const;
+
+    /**
+     * @brief The position of an index, in the unit of the mapper.
+     */
+    double positionAt(size_t index) const;
+
+    /**
+     * @brief The positions of count indices, in the unit of the mapper.
+     *
+     * @param indices           The indices.
+     * @param count             The number of indices.
+     * @param[out] positions    Buffer for count positions.
+     */
+    void positionAt(const size_t *indices, size_t count, double *positions) const;
+
+
+    std::vector<double> positionAt(const std::vector<size_t> &indices) const;
+
+private:
+
+    DimensionType  type;
+    double         scaling;      // unit of the positions -> unit of the dimension
+    double         offset;
+    double         interval;
+    size_t         label_count;
+    RangeDimension range;
+};
+
+} // namespace nix
+
+#endif // NIX_DIMENSION_MAPPER_H
@@ -594,7 +594,8 @@ public:
      * values. This can be used to store data that is sampled at irregular
      * intervals.
      *
-     * Ticks must be ordered in ascending order.
+     * Ticks must be ordered in ascending order. They are read once and
+     * cached; tickAt, indexOf and axis use the cached ticks.
      *
      * @return A vector with all ticks for the dimension.
      */
@@ -632,6 +633,18 @@ public:
      * @return The index.
      */
     size_t indexOf(const double position) const;
+
+    /**
+     * @brief Returns the indices of many positions at once.
+     *
+     * Equivalent to calling indexOf for every position, but the ticks are
+     * read only once and, for many positions, swept in a single pass.
+     *
+     * @param positions   The positions, preferably in ascending order.
+     *
+     * @return The index of every position.
+     */
+    std::vector<size_t> indexOf(const std::vector<double> &positions) const;
     
     /**
      * @brief Returns a vector containing a number of ticks
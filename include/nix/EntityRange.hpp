@@ -0,0 +1,237 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_RANGE_H
+#define NIX_ENTITY_RANGE_H
+
+#include <nix/util/filter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief A lazily evaluated range over the children of a container.
+ *
+ * The range only holds the keys (names or ids) of the candidates, as
+ * listed by the back-end. Entities are opened and filtered one by one
+ * while the range is iterated, so breaking out of a loop early does not
+ * pay for the remaining children. With {@link prefetch} the next entities
+ * are opened in batches.
+ *
+ * Name and id filters narrow the candidates when the range is created.
+ * Type filters do not, as the type can only be read from the opened
+ * entity; they are applied while iterating like any other filter.
+ *
+ * ~~~
+ * for (DataArray da : block.dataArrayRange(util::TypeFilter<DataArray>("ephys"))) {
+ *     if (done(da)) {
+ *         break;
+ *     }
+ * }
+ * ~~~
+ */
+template<typename T>
+class EntityRange {
+
+public:
+
+    typedef std::function<T(const std::string &)> getter_type;
+
+    typedef std::function<bool(const T &)> filter_type;
+
+private:
+
+    struct State {
+        std::vector<std::string> keys;
+        getter_type              getter;
+        filter_type              filter;
+        size_t                   prefetch;
+    };
+
+    std::shared_ptr<State> state;
+
+public:
+
+    class iterator {
+
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T                         value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef const T*                  pointer;
+        typedef const T&                  reference;
+
+        iterator()
+            : pos(0), next(0)
+        {}
+
+        const T &operator*() const {
+            return current;
+        }
+
+        const T *operator->() const {
+            return &current;
+        }
+
+        iterator &operator++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const {
+            return pos == other.pos && state == other.state;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+
+        friend class EntityRange;
+
+        iterator(const std::shared_ptr<State> &state, bool at_end)
+            : state(state), pos(at_end ? state->keys.size() : 0), next(pos)
+        {
+            if (!at_end) {
+                advance();
+            }
+        }
+
+        void advance() {
+            const std::vector<std::string> &keys = state->keys;
+
+            while (true) {
+                if (buffer.empty()) {
+                    if (next >= keys.size()) {
+                        pos = keys.size();
+                        current = T();
+                        return;
+                    }
+
+                    size_t n = std::max<size_t>(state->prefetch, 1);
+                    for (size_t i = 0; i < n && next < keys.size(); i++, next++) {
+                        buffer.push_back(state->getter(keys[next]));
+                    }
+                }
+
+                T candidate = buffer.front();
+                buffer.pop_front();
+                pos = next - buffer.size() - 1;
+
+                // skip children that vanished after the keys were listed
+                if (candidate && state->filter(candidate)) {
+                    current = candidate;
+                    return;
+                }
+            }
+        }
+
+        std::shared_ptr<State> state;
+        size_t                 pos;     // index of the key of current
+        size_t                 next;    // index of the next key to open
+        std::deque<T>          buffer;
+        T                      current;
+    };
+
+
+    EntityRange()
+        : state(std::make_shared<State>())
+    {
+        state->filter = util::AcceptAll<T>();
+        state->prefetch = 0;
+    }
+
+    /**
+     * @brief Create a range over the given keys.
+     *
+     * @param keys      Names or ids of the candidates.
+     * @param getter    Opens the entity for a key; may return an
+     *                  uninitialized entity, which is skipped.
+     * @param filter    Filter applied to every opened entity.
+     */
+    EntityRange(std::vector<std::string> keys, getter_type getter,
+                filter_type filter = util::AcceptAll<T>())
+        : state(std::make_shared<State>())
+    {
+        state->keys = std::move(keys);
+        state->getter = std::move(getter);
+        state->filter = std::move(filter);
+        state->prefetch = 0;
+    }
+
+    /**
+     * @brief Open the next count entities at once while iterating.
+     *
+     * @param count     The number of entities to open ahead.
+     *
+     * @return The range itself.
+     */
+    EntityRange &prefetch(size_t count) {
+        state->prefetch = count;
+        return *this;
+    }
+
+
+    iterator begin() const {
+        return iterator(state, false);
+    }
+
+
+    iterator end() const {
+        return iterator(state, true);
+    }
+
+    /**
+     * @brief The number of candidates; an upper bound of the number of
+     *        entities the range yields, which for a type filter counts
+     *        all children.
+     */
+    size_t size() const {
+        return state->keys.size();
+    }
+
+    /**
+     * @brief Check if the range yields no entity; opens the candidates
+     *        up to the first match.
+     */
+    bool empty() const {
+        return begin() == end();
+    }
+
+    /**
+     * @brief Open all entities of the range.
+     */
+    std::vector<T> toVector() const {
+        std::vector<T> entities;
+        for (const T &entity : *this) {
+            entities.push_back(entity);
+        }
+        return entities;
+    }
+
+};
+
+} // namespace nix
+
+#endif // NIX_ENTITY_RANGE_H
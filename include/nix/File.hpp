@@ -13,6 +13,8 @@
 #include <nix/base/IFile.hpp>
 #include <nix/Block.hpp>
 #include <nix/Section.hpp>
+#include <nix/ChunkCache.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 
 #include <nix/valid/validate.hpp>
@@ -90,6 +92,23 @@ public:
     static File open(const std::string &name, FileMode mode=FileMode::ReadWrite,
                      const std::string &impl="hdf5");
 
+    /**
+     * @brief Opens a file with custom chunk cache settings.
+     *
+     * The settings are used for all chunked data in the file unless a
+     * {@link nix::DataArray} overrides them.
+     *
+     * @param name      The name/path of the file.
+     * @param mode      The open mode.
+     * @param cache     The chunk cache settings.
+     * @param impl      The back-end implementation the should be used to open the file.
+     *                  (currently only hdf5)
+     *
+     * @return The opened file.
+     */
+    static File open(const std::string &name, FileMode mode, const ChunkCache &cache,
+                     const std::string &impl="hdf5");
+
     /**
      * @brief Get the number of blocks in in the file.
      *
@@ -199,6 +218,18 @@ public:
         return blocks(util::AcceptAll<Block>());
     }
 
+    /**
+     * @brief Lazily iterate over the blocks of this file.
+     *
+     * Unlike {@link blocks} the blocks are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered blocks.
+     */
+    EntityRange<Block> blockRange(const util::Filter<Block>::type &filter = util::AcceptAll<Block>()) const;
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -283,6 +314,18 @@ public:
     {
         return sections(util::AcceptAll<Section>());
     }
+
+    /**
+     * @brief Lazily iterate over the root sections of this file.
+     *
+     * Unlike {@link sections} the root sections are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered root sections.
+     */
+    EntityRange<Section> sectionRange(const util::Filter<Section>::type &filter = util::AcceptAll<Section>()) const;
     
 
     /**
@@ -351,6 +394,21 @@ public:
      */
     bool deleteSection(const Section &section);
 
+    /**
+     * @brief Read all metadata of the file into memory.
+     *
+     * All sections, properties and values are read in a single pass over
+     * the metadata of the file, which is much faster than walking the
+     * tree with {@link Section} and {@link Property} when most of it is
+     * needed. The returned tree is a snapshot and is not updated by later
+     * changes of the file.
+     *
+     * @return The metadata tree.
+     */
+    MetadataTree loadMetadataTree() const {
+        return MetadataTree(backend()->loadMetadataTree());
+    }
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -461,6 +519,35 @@ public:
     FileMode fileMode() {
         return backend()->fileMode();
     }
+
+    /**
+     * @brief Enable or disable the attribute cache for the entities of
+     *        the file.
+     *
+     * With the cache an entity reads all of its scalar attributes, such as
+     * name, type, unit or label, in one pass on first access and answers
+     * later reads from memory. Setters write through to the file and the
+     * cache. The setting applies to entities that are obtained after the
+     * call.
+     *
+     * The cache is enabled by default for files opened in ReadOnly mode.
+     * For writable files it is off by default, because separate entity
+     * objects for the same entity do not see each other's modifications.
+     *
+     * @param enabled   Whether the cache is used.
+     */
+    void attributeCache(bool enabled) {
+        backend()->attributeCache(enabled);
+    }
+
+    /**
+     * @brief Check whether the attribute cache is enabled.
+     *
+     * @return True if new entities use the attribute cache.
+     */
+    bool attributeCache() const {
+        return backend()->attributeCache();
+    }
     /**
      * @brief Assignment operator for none.
      */
@@ -0,0 +1,332 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_TREE_H
+#define NIX_METADATA_TREE_H
+
+#include <nix/DataType.hpp>
+#include <nix/Value.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief An immutable in-memory copy of all metadata sections and
+ *        properties of a file.
+ *
+ * The tree is read by {@link nix::File::loadMetadataTree} in a single pass
+ * over the file. Its {@link MetadataTree::Section} and
+ * {@link MetadataTree::Property} handles offer the read accessors of
+ * {@link nix::Section} and {@link nix::Property} without any file access;
+ * changes made to the file after loading are not reflected.
+ *
+ * ~~~
+ * MetadataTree tree = file.loadMetadataTree();
+ * for (const MetadataTree::Section &section : tree.sections()) {
+ *     for (const MetadataTree::Property &property : section.properties()) {
+ *         const std::vector<Value> &values = property.values();
+ *     }
+ * }
+ * ~~~
+ */
+class NIXAPI MetadataTree {
+
+public:
+
+    static const size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief A section as stored in the tree.
+     *
+     * Strings point into the string pool of the tree; optional attributes
+     * that are not set are nullptr. Relations are indices into the node
+     * arrays.
+     */
+    struct SectionNode {
+        const std::string  *id = nullptr;
+        const std::string  *name = nullptr;
+        const std::string  *type = nullptr;
+        const std::string  *definition = nullptr;
+        const std::string  *repository = nullptr;
+        const std::string  *mapping = nullptr;
+        time_t              created_at = 0;
+        time_t              updated_at = 0;
+        size_t              parent = npos;
+        size_t              link = npos;
+        std::vector<size_t> sections;
+        std::vector<size_t> properties;
+    };
+
+    /**
+     * @brief A property as stored in the tree.
+     */
+    struct PropertyNode {
+        const std::string  *id = nullptr;
+        const std::string  *name = nullptr;
+        const std::string  *definition = nullptr;
+        const std::string  *unit = nullptr;
+        const std::string  *mapping = nullptr;
+        time_t              created_at = 0;
+        time_t              updated_at = 0;
+        size_t              section = npos;
+        DataType            data_type = DataType::Nothing;
+        std::vector<Value>  values;
+    };
+
+    /**
+     * @brief The storage of a tree; filled by the back-end.
+     *
+     * All nodes are kept in two arrays, and every distinct string is stored
+     * once in the string pool.
+     */
+    struct NIXAPI Data {
+        std::vector<SectionNode>                sections;
+        std::vector<PropertyNode>               properties;
+        std::vector<size_t>                     roots;
+        std::unordered_set<std::string>         strings;
+        std::unordered_map<std::string, size_t> section_ids;
+
+        /**
+         * @brief The pooled copy of a string.
+         */
+        const std::string *intern(const std::string &str);
+    };
+
+    class Section;
+
+    /**
+     * @brief Read-only view of a property in a tree.
+     */
+    class NIXAPI Property {
+
+    public:
+
+        Property()
+            : index(npos)
+        {}
+
+
+        Property(const std::shared_ptr<const Data> &data, size_t index)
+            : data(data), index(index)
+        {}
+
+
+        bool isNone() const {
+            return index == npos;
+        }
+
+
+        explicit operator bool() const {
+            return !isNone();
+        }
+
+
+        const std::string &id() const;
+
+
+        const std::string &name() const;
+
+
+        boost::optional<std::string> definition() const;
+
+
+        boost::optional<std::string> unit() const;
+
+
+        boost::optional<std::string> mapping() const;
+
+
+        time_t createdAt() const;
+
+
+        time_t updatedAt() const;
+
+
+        DataType dataType() const;
+
+
+        ndsize_t valueCount() const;
+
+
+        const std::vector<Value> &values() const;
+
+        /**
+         * @brief The section the property belongs to.
+         */
+        MetadataTree::Section section() const;
+
+    private:
+
+        const PropertyNode &node() const;
+
+        std::shared_ptr<const Data> data;
+        size_t                      index;
+    };
+
+    /**
+     * @brief Read-only view of a section in a tree.
+     */
+    class NIXAPI Section {
+
+    public:
+
+        Section()
+            : index(npos)
+        {}
+
+
+        Section(const std::shared_ptr<const Data> &data, size_t index)
+            : data(data), index(index)
+        {}
+
+
+        bool isNone() const {
+            return index == npos;
+        }
+
+
+        explicit operator bool() const {
+            return !isNone();
+        }
+
+
+        const std::string &id() const;
+
+
+        const std::string &name() const;
+
+
+        const std::string &type() const;
+
+
+        boost::optional<std::string> definition() const;
+
+
+        boost::optional<std::string> repository() const;
+
+
+        boost::optional<std::string> mapping() const;
+
+
+        time_t createdAt() const;
+
+
+        time_t updatedAt() const;
+
+        /**
+         * @brief The linked section, or an empty handle if the section
+         *        is not linked.
+         */
+        Section link() const;
+
+        /**
+         * @brief The parent section, or an empty handle for root sections.
+         */
+        Section parent() const;
+
+
+        ndsize_t sectionCount() const;
+
+
+        bool hasSection(const std::string &name_or_id) const;
+
+
+        Section getSection(const std::string &name_or_id) const;
+
+
+        Section getSection(ndsize_t index) const;
+
+
+        std::vector<Section> sections() const;
+
+
+        ndsize_t propertyCount() const;
+
+
+        bool hasProperty(const std::string &name_or_id) const;
+
+
+        Property getProperty(const std::string &name_or_id) const;
+
+
+        Property getProperty(ndsize_t index) const;
+
+
+        std::vector<Property> properties() const;
+
+    private:
+
+        const SectionNode &node() const;
+
+        std::shared_ptr<const Data> data;
+        size_t                      index;
+    };
+
+    /**
+     * @brief An empty tree.
+     */
+    MetadataTree();
+
+
+    explicit MetadataTree(const std::shared_ptr<const Data> &data);
+
+    /**
+     * @brief The number of root sections.
+     */
+    ndsize_t sectionCount() const;
+
+
+    bool hasSection(const std::string &name_or_id) const;
+
+    /**
+     * @brief Get a root section by name or id.
+     */
+    Section getSection(const std::string &name_or_id) const;
+
+
+    Section getSection(ndsize_t index) const;
+
+    /**
+     * @brief All root sections.
+     */
+    std::vector<Section> sections() const;
+
+    /**
+     * @brief Get a section anywhere in the tree by its id.
+     */
+    Section findSection(const std::string &id) const;
+
+    /**
+     * @brief The total number of sections in the tree.
+     */
+    size_t totalSectionCount() const;
+
+    /**
+     * @brief The total number of properties in the tree.
+     */
+    size_t totalPropertyCount() const;
+
+private:
+
+    std::shared_ptr<const Data> data;
+};
+
+} // namespace nix
+
+#endif // NIX_METADATA_TREE_H
@@ -12,8 +12,10 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/EntityWithSources.hpp>
 #include <nix/Feature.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 #include <nix/DataView.hpp>
+#include <nix/DataSegments.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -322,6 +324,18 @@ public:
         return references(util::AcceptAll<DataArray>());
     }
 
+    /**
+     * @brief Lazily iterate over the referenced data arrays of this multi tag.
+     *
+     * Unlike {@link references} the referenced data arrays are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered referenced data arrays.
+     */
+    EntityRange<DataArray> referenceRange(const util::Filter<DataArray>::type &filter = util::AcceptAll<DataArray>()) const;
+
     /**
      * @brief Setter for all referenced DataArrays.
      *
@@ -345,6 +359,30 @@ public:
      */
     DataView retrieveData(size_t position_index, size_t reference_index) const;
 
+    /**
+     * @brief Retrieves the offsets and counts of the data slices tagged by
+     *        all positions and extents in a certain reference.
+     *
+     * Positions and extents are read only once, so this is the way to go
+     * for iterating over many positions.
+     *
+     * @param reference_index   The index of the requested reference.
+     * @param[out] offsets      The offset of every position.
+     * @param[out] counts       The element count of every position.
+     */
+    void retrieveOffsets(size_t reference_index, std::vector<NDSize> &offsets, std::vector<NDSize> &counts) const;
+
+    /**
+     * @brief Retrieves the data slices tagged by several positions and
+     *        extents of a certain reference at once.
+     *
+     * @param position_indices  The indices of the requested positions.
+     * @param reference_index   The index of the requested reference.
+     *
+     * @return The requested slices, stored back to back.
+     */
+    DataSegments retrieveDataBatch(const std::vector<size_t> &position_indices, size_t reference_index) const;
+
     //--------------------------------------------------
     // Methods concerning features.
     //--------------------------------------------------
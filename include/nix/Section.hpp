@@ -14,6 +14,7 @@
 #include <nix/base/ISection.hpp>
 #include <nix/Property.hpp>
 #include <nix/DataType.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 
 #include <memory>
@@ -260,6 +261,18 @@ public:
      */
     std::vector<Section> sections(const util::Filter<Section>::type &filter = util::AcceptAll<Section>()) const;
 
+    /**
+     * @brief Lazily iterate over the subsections of this section.
+     *
+     * Unlike {@link sections} the subsections are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered subsections.
+     */
+    EntityRange<Section> sectionRange(const util::Filter<Section>::type &filter = util::AcceptAll<Section>()) const;
+
     /**
      * @brief Get all descendant sections of the section recursively.
      *
@@ -383,6 +396,18 @@ public:
      */
     std::vector<Property> properties(const util::Filter<Property>::type &filter=util::AcceptAll<Property>()) const;
 
+    /**
+     * @brief Lazily iterate over the properties of this section.
+     *
+     * Unlike {@link properties} the properties are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered properties.
+     */
+    EntityRange<Property> propertyRange(const util::Filter<Property>::type &filter = util::AcceptAll<Property>()) const;
+
     /**
      * Returns all Properties inherited from a linked section.
      * This list may include Properties that are locally overridden.
@@ -460,11 +485,11 @@ public:
 
 private:
 
-    std::vector<Section> findDownstream(const std::function<bool(Section)> &filter) const;
+    std::vector<Section> findDownstream(const util::Filter<Section>::type &filter) const;
 
-    std::vector<Section> findUpstream(const std::function<bool(Section)> &filter) const;
+    std::vector<Section> findUpstream(const util::Filter<Section>::type &filter) const;
 
-    std::vector<Section> findSideways(const std::function<bool(Section)> &filter, const std::string &caller_id) const;
+    std::vector<Section> findSideways(const util::Filter<Section>::type &filter, const std::string &caller_id) const;
 
     size_t tree_depth() const;
 };
@@ -0,0 +1,166 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SEGMENT_REDUCER_H
+#define NIX_SEGMENT_REDUCER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/MultiTag.hpp>
+#include <nix/Platform.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Reduces the data slices tagged by the positions and extents of a
+ *        {@link nix::MultiTag}, e.g. to compute event-triggered averages.
+ *
+ * The slices are read in batches by the calling thread, which makes all
+ * HDF5 calls, and handed to a pool of worker threads that do the
+ * arithmetic. Only a few batches are held in memory at any time. The data
+ * is read as double, with the polynomial and expansion origin of the
+ * referenced DataArray applied.
+ *
+ * ~~~
+ * SegmentReducer reducer(spikes, 0);
+ * SegmentReducer::Stats sta = reducer.stats();
+ * // sta.mean is the spike-triggered average, sta.variance its variance
+ * ~~~
+ */
+class NIXAPI SegmentReducer {
+
+public:
+
+    /**
+     * @brief Element-wise statistics over slices of the same shape.
+     */
+    struct Stats {
+        NDSize              shape;      //!< the shape of a slice
+        size_t              count = 0;  //!< the number of slices
+        std::vector<double> sum;
+        std::vector<double> mean;
+        std::vector<double> variance;   //!< sample variance, zero for a single slice
+        std::vector<double> min;
+        std::vector<double> max;
+    };
+
+    /**
+     * @brief Receives a slice on a worker thread.
+     *
+     * @param worker    The index of the worker, less than workers().
+     * @param data      The elements of the slice in row-major order.
+     * @param count     The shape of the slice.
+     */
+    typedef std::function<void(size_t worker, const double *data, const NDSize &count)> consumer_type;
+
+    /**
+     * @brief Create a reducer for the data of a reference of a MultiTag.
+     *
+     * @param tag               The multi tag.
+     * @param reference_index   The index of the referenced DataArray.
+     * @param workers           The number of worker threads; 0 to use one per core.
+     * @param batch_bytes       The amount of data read at once.
+     */
+    SegmentReducer(const MultiTag &tag, size_t reference_index, size_t workers = 0,
+                   size_t batch_bytes = 4 * 1024 * 1024);
+
+    /**
+     * @brief The number of worker threads.
+     */
+    size_t workers() const {
+        return nworkers;
+    }
+
+    /**
+     * @brief Element-wise statistics over all positions.
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Element-wise statistics over the given positions.
+     *
+     * @param position_indices  The indices of the positions; all slices
+     *                          must have the same shape.
+     */
+    Stats stats(const std::vector<size_t> &position_indices) const;
+
+    /**
+     * @brief Reduce the given positions with a custom reducer.
+     *
+     * Every worker starts with a copy of init and passes the slices it
+     * receives to add. The per-worker results are combined with merge at
+     * the end. Slices reach the workers in no particular order, so init must
+     * be neutral and add and merge must not depend on the order.
+     *
+     * ~~~
+     * // histogram of the values
+     * std::vector<size_t> hist = reducer.reduce<std::vector<size_t>>(indices, std::vector<size_t>(10),
+     *     [](std::vector<size_t> &h, const double *data, const NDSize &count) {
+     *         for (ndsize_t i = 0; i < count.nelms(); i++) h[bin(data[i])]++;
+     *     },
+     *     [](std::vector<size_t> &h, const std::vector<size_t> &other) {
+     *         for (size_t i = 0; i < h.size(); i++) h[i] += other[i];
+     *     });
+     * ~~~
+     *
+     * @param position_indices  The indices of the positions.
+     * @param init              The initial value of every accumulator.
+     * @param add               Adds a slice to an accumulator.
+     * @param merge             Adds the second accumulator to the first.
+     *
+     * @return The merged accumulators.
+     */
+    template<typename Acc>
+    Acc reduce(const std::vector<size_t> &position_indices, const Acc &init,
+               const std::function<void(Acc &, const double *, const NDSize &)> &add,
+               const std::function<void(Acc &, const Acc &)> &merge) const;
+
+    /**
+     * @brief Read the given positions and pass every slice to consume on
+     *        one of the worker threads.
+     *
+     * Exceptions thrown by consume stop the reduction and are rethrown.
+     */
+    void stream(const std::vector<size_t> &position_indices, const consumer_type &consume) const;
+
+private:
+
+    std::vector<size_t> allPositions() const;
+
+    void stream(const std::vector<size_t> &position_indices, const std::vector<NDSize> &offsets,
+                const std::vector<NDSize> &counts, const consumer_type &consume) const;
+
+    MultiTag  tag;
+    DataArray array;
+    size_t    nworkers;
+    size_t    batch_bytes;
+};
+
+
+template<typename Acc>
+Acc SegmentReducer::reduce(const std::vector<size_t> &position_indices, const Acc &init,
+                           const std::function<void(Acc &, const double *, const NDSize &)> &add,
+                           const std::function<void(Acc &, const Acc &)> &merge) const {
+    std::vector<Acc> accs(nworkers, init);
+
+    stream(position_indices, [&](size_t worker, const double *data, const NDSize &count) {
+        add(accs[worker], data, count);
+    });
+
+    Acc result = accs[0];
+    for (size_t i = 1; i < accs.size(); i++) {
+        merge(result, accs[i]);
+    }
+    return result;
+}
+
+} // namespace nix
+
+#endif // NIX_SEGMENT_REDUCER_H
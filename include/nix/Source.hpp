@@ -13,6 +13,7 @@
 #include <nix/base/EntityWithMetadata.hpp>
 #include <nix/base/ISource.hpp>
 
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 
 #include <ostream>
@@ -147,6 +148,18 @@ public:
      */
     std::vector<Source> sources(const util::Filter<Source>::type &filter = util::AcceptAll<Source>()) const;
 
+    /**
+     * @brief Lazily iterate over the child sources of this source.
+     *
+     * Unlike {@link sources} the child sources are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered child sources.
+     */
+    EntityRange<Source> sourceRange(const util::Filter<Source>::type &filter = util::AcceptAll<Source>()) const;
+
     /**
      * @brief Get all descendant sources of the source recursively.
      *
@@ -14,6 +14,7 @@
 #include <nix/DataArray.hpp>
 #include <nix/Feature.hpp>
 #include <nix/DataView.hpp>
+#include <nix/EntityRange.hpp>
 #include <nix/Platform.hpp>
 
 #include <algorithm>
@@ -304,6 +305,18 @@ public:
         return references(util::AcceptAll<DataArray>());
     }
 
+    /**
+     * @brief Lazily iterate over the referenced data arrays of this tag.
+     *
+     * Unlike {@link references} the referenced data arrays are only opened while the
+     * range is iterated.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A range over the filtered referenced data arrays.
+     */
+    EntityRange<DataArray> referenceRange(const util::Filter<DataArray>::type &filter = util::AcceptAll<DataArray>()) const;
+
     /**
      * @brief Sets all referenced DataArray entities.
      *
@@ -15,6 +15,7 @@
 #include <nix/base/IEntityWithSources.hpp>
 #include <nix/base/IDataArray.hpp>
 #include <nix/base/IFeature.hpp>
+#include <nix/util/filter.hpp>
 
 namespace nix {
 
@@ -45,6 +46,12 @@ public:
     virtual std::shared_ptr<IDataArray> getReference(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IDataArray>> getReferences(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> referenceKeys(const util::Match &match) const = 0;
+
+
     virtual void addReference(const std::string &id) = 0;
 
 
@@ -68,6 +75,9 @@ public:
     virtual std::shared_ptr<IFeature> getFeature(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IFeature>> getFeatures(const util::Match &match) const = 0;
+
+
     virtual std::shared_ptr<IFeature> createFeature(const std::string &data_array_id, LinkType link_type) = 0;
 
 
@@ -15,6 +15,7 @@
 #include <nix/base/ITag.hpp>
 #include <nix/base/IMultiTag.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/util/filter.hpp>
 
 #include <string>
 #include <vector>
@@ -42,8 +43,20 @@ public:
     virtual std::shared_ptr<base::ISource> getSource(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::ISource>> getSources(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> sourceKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t sourceCount() const = 0;
 
+    /**
+     * @brief Find the sources in all source trees of the block that are
+     *        selected by a match, in breadth-first order per root source.
+     */
+    virtual std::vector<std::shared_ptr<base::ISource>> findSources(const util::Match &match, size_t max_depth) const = 0;
+
 
     virtual std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type) = 0;
 
@@ -63,11 +76,19 @@ public:
     virtual std::shared_ptr<base::IDataArray> getDataArray(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::IDataArray>> getDataArrays(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> dataArrayKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t dataArrayCount() const = 0;
 
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                              nix::DataType data_type, const NDSize &shape) = 0;
+                                                              nix::DataType data_type, const NDSize &shape,
+                                                              const Compression &compression,
+                                                              const NDSize &chunks) = 0;
 
 
     virtual bool deleteDataArray(const std::string &name_or_id) = 0;
@@ -85,6 +106,12 @@ public:
     virtual std::shared_ptr<base::ITag> getTag(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::ITag>> getTags(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> tagKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t tagCount() const = 0;
 
 
@@ -107,6 +134,12 @@ public:
     virtual std::shared_ptr<base::IMultiTag> getMultiTag(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::IMultiTag>> getMultiTags(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> multiTagKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t multiTagCount() const = 0;
 
 
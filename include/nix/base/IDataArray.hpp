@@ -13,6 +13,9 @@
 #include <nix/base/IDimensions.hpp>
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/ChunkCache.hpp>
+#include <nix/Compression.hpp>
+#include <nix/Chunking.hpp>
 
 #include <string>
 #include <vector>
@@ -20,6 +23,10 @@
 namespace nix {
 namespace base {
 
+class ITag;
+class IMultiTag;
+class IFeature;
+
 /**
  * @brief Interface for implementations of the DataArray entity.
  *
@@ -117,7 +124,8 @@ public:
      * @param dtype     The data type that should be stored in this data array.
      * @param size      The size of the data to store.
      */
-    virtual void createData(DataType dtype, const NDSize &size) = 0;
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const NDSize &chunks) = 0;
 
     /**
      * @brief Check if the data array has some data.
@@ -146,6 +154,20 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read several slices of the data array at once.
+     *
+     * The slices are stored back to back in buffer, in the order in which
+     * they were requested. Slices may overlap.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer where the data is written.
+     * @param offsets   The position where each slice starts.
+     * @param counts    The size of each slice.
+     */
+    virtual void readSegments(DataType dtype, void *buffer,
+                              const std::vector<NDSize> &offsets, const std::vector<NDSize> &counts) const = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
@@ -155,6 +177,50 @@ public:
 
     virtual DataType dataType(void) const = 0;
 
+    /**
+     * @brief The chunk shape of the stored data.
+     *
+     * @return The chunk shape or an empty NDSize if the data is not chunked.
+     */
+    virtual NDSize dataChunks(void) const = 0;
+
+    /**
+     * @brief Set the chunk cache used to access the data.
+     *
+     * @param cache     The chunk cache settings.
+     */
+    virtual void chunkCache(const ChunkCache &cache) = 0;
+
+
+    virtual ChunkCache chunkCache(void) const = 0;
+
+    /**
+     * @brief The filters the data was created with.
+     */
+    virtual Compression compression(void) const = 0;
+
+    //--------------------------------------------------
+    // Methods concerning entities that refer to the data array
+    //--------------------------------------------------
+
+    /**
+     * @brief The tags of the block that link to the data array as a
+     *        reference or through a feature.
+     */
+    virtual std::vector<std::shared_ptr<ITag>> referringTags() const = 0;
+
+    /**
+     * @brief The multi-tags of the block that link to the data array as a
+     *        reference, through a feature, or as positions or extents.
+     */
+    virtual std::vector<std::shared_ptr<IMultiTag>> referringMultiTags() const = 0;
+
+    /**
+     * @brief The features of the tags and multi-tags of the block that
+     *        link to the data array.
+     */
+    virtual std::vector<std::shared_ptr<IFeature>> referringFeatures() const = 0;
+
     /**
      * @brief Destructor
      */
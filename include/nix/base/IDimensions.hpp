@@ -12,6 +12,7 @@
 #include <nix/Platform.hpp>
 
 #include <string>
+#include <memory>
 #include <vector>
 #include <ostream>
 
@@ -161,6 +162,14 @@ public:
 
     virtual void ticks(const std::vector<double> &ticks) = 0;
 
+    /**
+     * @brief The ticks of the dimension, shared instead of copied.
+     *
+     * The returned vector is never modified; setting new ticks makes the
+     * back-end return a new one.
+     */
+    virtual std::shared_ptr<const std::vector<double>> sharedTicks() const = 0;
+
 
     virtual ~IRangeDimension() {}
 
@@ -13,6 +13,7 @@
 
 #include <nix/base/ISource.hpp>
 #include <nix/base/IEntityWithMetadata.hpp>
+#include <nix/util/filter.hpp>
 
 #include <string>
 #include <vector>
@@ -55,6 +56,9 @@ public:
     virtual std::shared_ptr<ISource> getSource(const size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISource>> getSources(const util::Match &match) const = 0;
+
+
     virtual ~IEntityWithSources() {}
 
 };
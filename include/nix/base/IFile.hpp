@@ -11,7 +11,9 @@
 
 #include <nix/base/ISection.hpp>
 #include <nix/base/IBlock.hpp>
+#include <nix/MetadataTree.hpp>
 #include <nix/Platform.hpp>
+#include <nix/util/filter.hpp>
 
 #include <string>
 #include <vector>
@@ -52,6 +54,12 @@ public:
     virtual std::shared_ptr<IBlock> getBlock(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IBlock>> getBlocks(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> blockKeys(const util::Match &match) const = 0;
+
+
     virtual std::shared_ptr<IBlock> createBlock(const std::string &name, const std::string &type) = 0;
 
 
@@ -70,14 +78,29 @@ public:
     virtual std::shared_ptr<ISection> getSection(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISection>> getSections(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> sectionKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t sectionCount() const = 0;
 
+    /**
+     * @brief Find the sections in the whole tree that are selected by
+     *        a match, in breadth-first order per root section.
+     */
+    virtual std::vector<std::shared_ptr<ISection>> findSections(const util::Match &match, size_t max_depth) const = 0;
+
 
     virtual std::shared_ptr<ISection> createSection(const std::string &name, const std::string &type) = 0;
 
 
     virtual bool deleteSection(const std::string &name_or_id) = 0;
 
+
+    virtual std::shared_ptr<MetadataTree::Data> loadMetadataTree() const = 0;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -117,6 +140,15 @@ public:
 
     virtual FileMode fileMode() const = 0;
 
+    /**
+     * @brief Enable or disable the attribute cache of the entities that
+     *        are opened from now on.
+     */
+    virtual void attributeCache(bool enabled) = 0;
+
+
+    virtual bool attributeCache() const = 0;
+
 
     virtual ~IFile() {}
 
@@ -16,6 +16,7 @@
 #include <nix/DataType.hpp>
 #include <nix/Value.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/util/filter.hpp>
 
 #include <string>
 #include <vector>
@@ -84,6 +85,19 @@ public:
     virtual std::shared_ptr<ISection> getSection(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISection>> getSections(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> sectionKeys(const util::Match &match) const = 0;
+
+    /**
+     * @brief Find the sections in the subtree of this section, including
+     *        the section itself, that are selected by a match, in
+     *        breadth-first order.
+     */
+    virtual std::vector<std::shared_ptr<ISection>> findSections(const util::Match &match, size_t max_depth) const = 0;
+
+
     virtual std::shared_ptr<ISection> createSection(const std::string &name, const std::string &type) = 0;
 
 
@@ -105,6 +119,12 @@ public:
     virtual std::shared_ptr<IProperty> getProperty(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IProperty>> getProperties(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> propertyKeys(const util::Match &match) const = 0;
+
+
     virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const DataType &dtype) = 0;
 
 
@@ -11,9 +11,11 @@
 
 
 #include <nix/base/IEntityWithMetadata.hpp>
+#include <nix/util/filter.hpp>
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace nix {
 namespace base {
@@ -37,8 +39,21 @@ public:
     virtual std::shared_ptr<ISource> getSource(ndsize_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISource>> getSources(const util::Match &match) const = 0;
+
+
+    virtual std::vector<std::string> sourceKeys(const util::Match &match) const = 0;
+
+
     virtual ndsize_t sourceCount() const = 0;
 
+    /**
+     * @brief Find the sources in the subtree of this source, including
+     *        the source itself, that are selected by a match, in
+     *        breadth-first order.
+     */
+    virtual std::vector<std::shared_ptr<ISource>> findSources(const util::Match &match, size_t max_depth) const = 0;
+
 
     virtual std::shared_ptr<ISource> createSource(const std::string &name, const std::string &type) = 0;
 
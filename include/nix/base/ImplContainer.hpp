@@ -76,6 +76,35 @@ protected:
         return entities;
     }
 
+    /**
+     * Low level helper to wrap and filter multiple entities that were
+     * obtained from the backend in a single call.
+     *
+     * The template param specifies the front-end type of the entities,
+     * the backend type is deduced from the passed vector.
+     *
+     * @param impls             The backend entities.
+     * @param filter            Filter function.
+     *
+     * @return A vector with all filtered entities.
+     */
+    template<typename TENT, typename TIMPL>
+    std::vector<TENT> getEntities(
+        const std::vector<std::shared_ptr<TIMPL>> &impls,
+        std::function<bool(TENT)> filter) const
+    {
+        std::vector<TENT> entities;
+
+        for (const auto &impl : impls) {
+            TENT candidate(impl);
+            if (candidate && filter(candidate)) {
+                entities.push_back(candidate);
+            }
+        }
+
+        return entities;
+    }
+
 public:
 
     ImplContainer()
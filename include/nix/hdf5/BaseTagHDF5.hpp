@@ -11,6 +11,7 @@
 #define NIX_BASETAG_HDF5_H
 
 #include <nix/hdf5/EntityWithSourcesHDF5.hpp>
+#include <nix/hdf5/ReferenceIndex.hpp>
 #include <nix/base/IBaseTag.hpp>
 
 namespace nix {
@@ -62,6 +63,12 @@ public:
     virtual std::shared_ptr<base::IDataArray> getReference(size_t index) const;
 
 
+    virtual std::vector<std::shared_ptr<base::IDataArray>> getReferences(const util::Match &match) const;
+
+
+    virtual std::vector<std::string> referenceKeys(const util::Match &match) const;
+
+
     virtual void addReference(const std::string &name_or_id);
 
 
@@ -86,6 +93,9 @@ public:
     virtual std::shared_ptr<base::IFeature> getFeature(size_t index) const;
 
 
+    virtual std::vector<std::shared_ptr<base::IFeature>> getFeatures(const util::Match &match) const;
+
+
     virtual std::shared_ptr<base::IFeature> createFeature(const std::string &name_or_id, LinkType link_type);
 
 
@@ -101,6 +111,14 @@ public:
     */
     virtual ~BaseTagHDF5();
 
+protected:
+
+    // the reference index of the block of the tag
+    ReferenceIndex &referenceIndex() const;
+
+    // a link of the tag to a data array, as stored in the reference index
+    ReferenceIndex::Referrer referrer(ReferenceIndex::Role role, const std::string &feature_id = "") const;
+
 };
 
 
@@ -75,9 +75,18 @@ public:
     std::shared_ptr<base::ISource> getSource(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> getSources(const util::Match &match) const;
+
+
+    std::vector<std::string> sourceKeys(const util::Match &match) const;
+
+
     ndsize_t sourceCount() const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> findSources(const util::Match &match, size_t max_depth) const;
+
+
     std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
 
 
@@ -96,11 +105,19 @@ public:
     std::shared_ptr<base::IDataArray> getDataArray(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IDataArray>> getDataArrays(const util::Match &match) const;
+
+
+    std::vector<std::string> dataArrayKeys(const util::Match &match) const;
+
+
     ndsize_t dataArrayCount() const;
 
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                      nix::DataType data_type, const NDSize &shape);
+                                                      nix::DataType data_type, const NDSize &shape,
+                                                      const Compression &compression,
+                                                      const NDSize &chunks);
 
 
     bool deleteDataArray(const std::string &name_or_id);
@@ -118,6 +135,12 @@ public:
     std::shared_ptr<base::ITag> getTag(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ITag>> getTags(const util::Match &match) const;
+
+
+    std::vector<std::string> tagKeys(const util::Match &match) const;
+
+
     ndsize_t tagCount() const;
 
 
@@ -140,6 +163,12 @@ public:
     std::shared_ptr<base::IMultiTag> getMultiTag(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IMultiTag>> getMultiTags(const util::Match &match) const;
+
+
+    std::vector<std::string> multiTagKeys(const util::Match &match) const;
+
+
     ndsize_t multiTagCount() const;
 
 
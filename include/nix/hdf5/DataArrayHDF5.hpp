@@ -32,6 +32,20 @@ private:
 
     optGroup dimension_group;
 
+    // the "data" DataSet is opened on first use and kept open, together
+    // with its data type, to save the per-call lookups; the extent is not
+    // kept, other handles to the same data may resize it
+    mutable DataSet  data_set;
+    mutable DataType data_type = DataType::Nothing;
+
+    // memory dataspace reused for hyperslab I/O, recreated only if the
+    // count changes; the file space is fetched per call, see data_set
+    mutable DataSpace mem_space;
+    mutable NDSize    mem_count;
+
+    // chunk cache settings the "data" DataSet is opened with, if any
+    boost::optional<ChunkCache> chunk_cache;
+
 public:
 
     /**
@@ -128,7 +142,8 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size);
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const NDSize &chunks);
 
 
     bool hasData() const;
@@ -140,6 +155,10 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void readSegments(DataType dtype, void *buffer,
+                      const std::vector<NDSize> &offsets, const std::vector<NDSize> &counts) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -148,10 +167,43 @@ public:
 
     DataType dataType(void) const;
 
+
+    NDSize dataChunks(void) const;
+
+
+    void chunkCache(const ChunkCache &cache);
+
+
+    ChunkCache chunkCache(void) const;
+
+
+    Compression compression(void) const;
+
+
+    std::vector<std::shared_ptr<base::ITag>> referringTags() const;
+
+
+    std::vector<std::shared_ptr<base::IMultiTag>> referringMultiTags() const;
+
+
+    std::vector<std::shared_ptr<base::IFeature>> referringFeatures() const;
+
 private:
 
     // small helper for handling dimension groups
     Group createDimensionGroup(size_t index);
+
+    // opens the "data" DataSet if necessary, false if it does not exist
+    bool openDataSet() const;
+
+    // caches an opened or newly created "data" DataSet
+    void cacheDataSet(const DataSet &ds) const;
+
+    // selects count elements at offset in the current file dataspace
+    Selection fileSelection(const NDSize &count, const NDSize &offset) const;
+
+    // the reusable memory dataspace for a buffer of the given count
+    Selection memSelection(const NDSize &count) const;
 };
 
 
@@ -15,6 +15,8 @@
 #include <nix/hdf5/LocID.hpp>
 #include <nix/Hydra.hpp>
 #include <nix/Value.hpp>
+#include <nix/ChunkCache.hpp>
+#include <nix/Compression.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -63,12 +65,33 @@ public:
 
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
-    static h5x::DataType fileTypeForValue(DataType dtype);
-    static h5x::DataType memTypeForValue(DataType dtype);
+    /**
+     * @brief The compound types of Property values; they are created once
+     *        per DataType, shared and must not be modified.
+     */
+    static const h5x::DataType &fileTypeForValue(DataType dtype);
+    static const h5x::DataType &memTypeForValue(DataType dtype);
 
     DataType dataType(void) const;
 
     DataSpace getSpace() const;
+
+    /**
+     * @brief The chunk shape of the DataSet.
+     *
+     * @return The chunk shape or an empty NDSize if the DataSet is not chunked.
+     */
+    NDSize chunking() const;
+
+    /**
+     * @brief The chunk cache settings the DataSet was opened with.
+     */
+    ChunkCache chunkCache() const;
+
+    /**
+     * @brief The filters the DataSet was created with.
+     */
+    Compression compression() const;
 };
 
 
@@ -49,6 +49,13 @@ NIXAPI h5x::DataType data_type_to_h5_filetype(DataType dtype);
 
 NIXAPI h5x::DataType data_type_to_h5_memtype(DataType dtype);
 
+/**
+ * Like data_type_to_h5_memtype() but returns a process wide instance
+ * that is created once per DataType. The returned type is shared and
+ * must not be modified.
+ */
+NIXAPI const h5x::DataType &cached_h5_memtype(DataType dtype);
+
 NIXAPI DataType data_type_from_h5(H5T_class_t vclass, size_t vsize, H5T_sign_t vsign);
 
 } // namespace hdf5
@@ -178,11 +178,25 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    std::shared_ptr<const std::vector<double>> sharedTicks() const;
+
+
     virtual ~RangeDimensionHDF5();
 
+    /**
+     * @brief Invalidate the cached ticks of all range dimensions.
+     *
+     * Must be called whenever data is written that may serve as the
+     * ticks of an aliased dimension.
+     */
+    static void invalidateTicks();
+
 private:
 
     Group redirectGroup() const;
+
+    mutable std::shared_ptr<const std::vector<double>> tick_cache;
+    mutable size_t tick_generation = 0;
 };
 
 
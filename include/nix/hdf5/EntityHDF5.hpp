@@ -16,10 +16,54 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace nix {
 namespace hdf5 {
 
+class FileHDF5;
+
+/**
+ * Counters of the attribute cache used by {@link EntityHDF5}.
+ *
+ * When the cache is active an entity reads all of its scalar string and
+ * floating point attributes in one pass on first access and answers
+ * later reads from memory; setters write through to the file and the
+ * cache. Whether entities use the cache is a setting of their file, see
+ * {@link nix::File::attributeCache}. The counters are shared by all files.
+ */
+class NIXAPI AttributeCache {
+
+public:
+
+    /**
+     * @brief Number of attribute reads served from the cache.
+     */
+    static size_t hits();
+
+    /**
+     * @brief Number of attribute reads that had to access the file.
+     */
+    static size_t misses();
+
+
+    static void resetCounters();
+
+};
+
+/**
+ * Read all scalar variable-length string and floating point attributes of
+ * an object in one pass over its attributes. Other attributes, including
+ * fixed-length strings written by other programs, are not read; their
+ * names are added to others if it is given.
+ */
+NIXAPI void readScalarAttrs(hid_t object,
+                            std::unordered_map<std::string, std::string> &strings,
+                            std::unordered_map<std::string, double> &numbers,
+                            std::unordered_set<std::string> *others = nullptr);
+
+
 
 /**
  * HDF5 implementation of IEntity
@@ -31,6 +75,14 @@ private:
     std::shared_ptr<base::IFile>  entity_file;
     Group                         entity_group;
 
+    mutable std::string                                  entity_id;
+    bool                                                 attr_cache = false;
+    mutable bool                                         attrs_cached = false;
+    mutable std::unordered_map<std::string, std::string> cached_strings;
+    mutable std::unordered_map<std::string, double>      cached_numbers;
+    // attributes that exist but are not cached; read from the file
+    mutable std::unordered_set<std::string>              uncached;
+
 public:
 
     EntityHDF5(const std::shared_ptr<base::IFile> &file, const Group &group);
@@ -75,6 +127,32 @@ protected:
 
     std::shared_ptr<base::IFile> file() const;
 
+    // the file as FileHDF5, for access to its indexes
+    std::shared_ptr<FileHDF5> fileHDF5() const;
+
+    // attribute access through the attribute cache (see AttributeCache)
+
+    bool hasCachedAttr(const std::string &name) const;
+
+
+    bool getCachedAttr(const std::string &name, std::string &value) const;
+
+
+    bool getCachedAttr(const std::string &name, double &value) const;
+
+
+    void setCachedAttr(const std::string &name, const std::string &value);
+
+
+    void setCachedAttr(const std::string &name, double value);
+
+
+    void removeCachedAttr(const std::string &name);
+
+private:
+
+    void fillAttrCache() const;
+
 };
 
 
@@ -72,6 +72,8 @@ public:
 
     std::shared_ptr<base::ISource> getSource(const size_t index) const;
 
+    std::vector<std::shared_ptr<base::ISource>> getSources(const util::Match &match) const;
+
     /**
      * Destructor.
      */
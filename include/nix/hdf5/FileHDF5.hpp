@@ -12,9 +12,12 @@
 #include <nix/base/IFile.hpp>
 
 #include <nix/hdf5/Group.hpp>
+#include <nix/hdf5/TreeIndex.hpp>
+#include <nix/hdf5/ReferenceIndex.hpp>
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace nix {
 namespace hdf5 {
@@ -30,6 +33,16 @@ private:
     /* groups representing different sections of the file */
     Group root, metadata, data;
     FileMode mode;
+    bool attr_cache;
+
+    // index of all sections, maintained by the sections of this file
+    std::unique_ptr<TreeIndex> section_index;
+
+    // indexes of the sources of the blocks, by block name
+    mutable std::unordered_map<std::string, std::unique_ptr<TreeIndex>> source_indexes;
+
+    // indexes of the links from tags to data arrays of the blocks, by block name
+    mutable std::unordered_map<std::string, std::unique_ptr<ReferenceIndex>> reference_indexes;
 
 public:
 
@@ -39,8 +52,10 @@ public:
      * @param name    The name of the file to open.
      * @param prefix  The prefix used for IDs.
      * @param mode    File open mode ReadOnly, ReadWrite or Overwrite.
+     * @param cache   Default chunk cache settings for all data in the file.
      */
-    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite);
+    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite,
+             const ChunkCache &cache = ChunkCache());
 
     //--------------------------------------------------
     // Methods concerning blocks
@@ -59,6 +74,12 @@ public:
     std::shared_ptr<base::IBlock> getBlock(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IBlock>> getBlocks(const util::Match &match) const;
+
+
+    std::vector<std::string> blockKeys(const util::Match &match) const;
+
+
     std::shared_ptr<base::IBlock> createBlock(const std::string &name, const std::string &type);
 
 
@@ -77,14 +98,72 @@ public:
     std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISection>> getSections(const util::Match &match) const;
+
+
+    std::vector<std::string> sectionKeys(const util::Match &match) const;
+
+
     ndsize_t sectionCount() const;
 
 
+    std::vector<std::shared_ptr<base::ISection>> findSections(const util::Match &match, size_t max_depth) const;
+
+
     std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
 
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    std::shared_ptr<MetadataTree::Data> loadMetadataTree() const;
+
+    /**
+     * @brief The index of the sections of the file.
+     *
+     * It is built on first use and kept up to date by all sections that
+     * are opened through this file. Changes made through another handle
+     * of the same file are not seen.
+     */
+    TreeIndex &sectionIndex() const;
+
+    /**
+     * @brief Open the section of an index entry together with its parents
+     *        up to ancestor, or up to the root if ancestor is not one of
+     *        them.
+     */
+    std::shared_ptr<base::ISection> openSection(const TreeIndex::Entry &entry,
+                                                const std::shared_ptr<base::ISection> &ancestor = nullptr) const;
+
+    /**
+     * @brief The index of the sources of a block.
+     *
+     * Like the section index it is built on first use and kept up to date
+     * by the blocks and sources of this file.
+     *
+     * @param block     The name of the block.
+     *
+     * @return The index, or nullptr if the block has no sources.
+     */
+    TreeIndex *sourceIndex(const std::string &block) const;
+
+    /**
+     * @brief The index of the tags and multi-tags of a block that refer
+     *        to its data arrays.
+     *
+     * @param block     The name of the block.
+     */
+    ReferenceIndex &referenceIndex(const std::string &block) const;
+
+    // sections by id that were already opened, e.g. for one query
+    typedef std::unordered_map<std::string, std::shared_ptr<base::ISection>> SectionMap;
+
+    /**
+     * @brief Open the section of an index entry, reusing the sections and
+     *        parents in opened; the newly opened ones are added to it.
+     */
+    std::shared_ptr<base::ISection> openSection(const TreeIndex::Entry &entry, SectionMap &opened) const;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -126,6 +205,12 @@ public:
     FileMode fileMode() const;
 
 
+    void attributeCache(bool enabled);
+
+
+    bool attributeCache() const;
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
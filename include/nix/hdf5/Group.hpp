@@ -14,9 +14,11 @@
 #include <nix/hdf5/DataSpace.hpp>
 #include <nix/Hydra.hpp>
 #include <nix/Platform.hpp>
+#include <nix/util/filter.hpp>
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -44,15 +46,89 @@ public:
     ndsize_t objectCount() const;
     std::string objectName(ndsize_t index) const;
 
+    /**
+     * @brief Visit all direct child objects of the group in a single
+     *        pass over its links.
+     *
+     * The children are visited in the same order in which they are
+     * returned by {@link objectName}. Every object is opened exactly
+     * once and passed to the visitor together with its link name and
+     * object type. Links that cannot be resolved are skipped.
+     *
+     * @param visitor   Called for every child; returning false stops
+     *                  the iteration.
+     */
+    void visitObjects(const std::function<bool(const std::string &, H5O_type_t, const LocID &)> &visitor) const;
+
+    /**
+     * @brief Collect all direct sub-groups of the group in a single pass.
+     *
+     * @return The opened sub-groups in link order.
+     */
+    std::vector<Group> groups() const;
+
+    /**
+     * @brief Collect all direct sub-datasets of the group in a single pass.
+     *
+     * @return The opened datasets in link order.
+     */
+    std::vector<DataSet> dataSets() const;
+
+    /**
+     * @brief Names of the direct children that satisfy a match.
+     *
+     * Matches on what the link names stand for are decided on the names
+     * alone and id matches in name-linked groups use the cached
+     * "entity_id" index. Other matches read a single attribute of each
+     * child; no entity is instantiated for that.
+     *
+     * @param match         The match to evaluate.
+     * @param link_field    What the link names of this group are, i.e.
+     *                      the names or the ids of the entities.
+     *
+     * @return The matching link names in link order.
+     */
+    std::vector<std::string> matchingLinks(const util::Match &match, util::Match::Field link_field) const;
+
+    /**
+     * @brief Collect the direct sub-groups that satisfy a match; only
+     *        those are opened.
+     *
+     * @return The opened sub-groups in link order.
+     */
+    std::vector<Group> groups(const util::Match &match,
+                              util::Match::Field link_field = util::Match::Field::Name) const;
+
+    /**
+     * @brief Collect the direct sub-datasets that satisfy a match; only
+     *        those are opened.
+     *
+     * @return The opened datasets in link order.
+     */
+    std::vector<DataSet> dataSets(const util::Match &match,
+                                  util::Match::Field link_field = util::Match::Field::Name) const;
+
     bool hasData(const std::string &name) const;
 
-    DataSet createData(const std::string &name, DataType dtype, const NDSize &size) const;
+    DataSet createData(const std::string &name, DataType dtype, const NDSize &size,
+            const Compression &compression = Compression(), const NDSize &chunks = {}) const;
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
             const NDSize &size, const NDSize &maxsize = {}, NDSize chunks = {},
-            bool maxSizeUnlimited = true, bool guessChunks = true) const;
+            bool maxSizeUnlimited = true, bool guessChunks = true,
+            const Compression &compression = Compression()) const;
 
     DataSet openData(const std::string &name) const;
+
+    /**
+     * @brief Open a dataset with custom chunk cache settings.
+     *
+     * @param name    The name of the dataset.
+     * @param cache   The chunk cache settings for this dataset.
+     *
+     * @return The opened dataset.
+     */
+    DataSet openData(const std::string &name, const ChunkCache &cache) const;
     void removeData(const std::string &name);
 
     template<typename T>
@@ -122,6 +198,12 @@ public:
     * @param attribute The name of the attribute to search.
     * @param value     The name of the Group or the value of the attribute to look for.
     *
+    * The attribute lookup is answered from a cached index that maps the
+    * attribute value to the link name. The index is built on first use,
+    * refreshed when links are added and rebuilt when links were removed
+    * or renamed; every hit is verified against the file. The attribute
+    * is therefore expected to be immutable once set (e.g. "entity_id").
+    *
     * @return Optional containing the located Group or empty optional otherwise.
     */
     boost::optional<Group> findGroupByNameOrAttribute(std::string const &attribute, std::string const &value) const;
@@ -135,6 +217,8 @@ public:
     * @param attribute The name of the attribute to search.
     * @param value     The name of the Group or the value of the attribute to look for.
     *
+    * Uses the same cached attribute index as {@link findGroupByNameOrAttribute}.
+    *
     * @return Optional containing the located Dataset or empty optional otherwise.
     */
     boost::optional<DataSet> findDataByNameOrAttribute(std::string const &attribute, std::string const &value) const;
@@ -172,6 +256,12 @@ public:
      */
     bool removeAllLinks(const std::string &name);
 
+    /**
+     * @brief Drop all cached attribute indexes of the file this group
+     *        belongs to. Must be called before the file is closed.
+     */
+    void releaseIndexes() const;
+
     virtual ~Group();
 
 
@@ -179,6 +269,11 @@ private:
 
     bool objectOfType(const std::string &name, H5O_type_t type) const;
 
+    boost::optional<std::string> findLinkByAttribute(const std::string &attribute, const std::string &value) const;
+
+    // drops a link that is about to be removed from the attribute indexes
+    void linkRemoved(const std::string &path) const;
+
 }; // group Group
 
 
@@ -26,6 +26,7 @@ class PropertyHDF5 : virtual public base::IProperty {
     
     std::shared_ptr<base::IFile>  entity_file;
     DataSet                       entity_dataset;
+    mutable DataType              data_type = DataType::Nothing;   // the type of a data set never changes
 
 public:
 
@@ -0,0 +1,139 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REFERENCE_INDEX_H
+#define NIX_REFERENCE_INDEX_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/Platform.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief In-memory index of the tags and multi-tags of a block that refer
+ *        to its data arrays.
+ *
+ * Tags link to data arrays as references and through the data of their
+ * features, multi-tags additionally as positions and extents. The index
+ * maps the id of a data array to these links, so that the referrers of an
+ * array can be found without reading every tag of the block.
+ *
+ * The index is built in a single traversal of the tags and multi-tags on
+ * first use. Afterwards it is kept up to date by the tags and features of
+ * the block; all changes are ignored as long as the index has not been
+ * built.
+ */
+class NIXAPI ReferenceIndex {
+
+public:
+
+    enum class Role {
+        Reference, Feature, Positions, Extents
+    };
+
+
+    struct Referrer {
+        Role        role;
+        bool        multi_tag;    //!< whether the referrer is a multi-tag or a tag
+        std::string tag_id;
+        std::string tag_name;     //!< name of the tag group in the block
+        std::string feature_id;   //!< id of the feature for Role::Feature, else empty
+
+        bool operator==(const Referrer &other) const {
+            return role == other.role && tag_id == other.tag_id && feature_id == other.feature_id;
+        }
+    };
+
+
+    explicit ReferenceIndex(const Group &block);
+
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    /**
+     * @brief All links to a data array, in the order of the tags.
+     */
+    const std::vector<Referrer> &find(const std::string &array_id) const;
+
+    /**
+     * @brief Open the group of the tag or multi-tag of a referrer.
+     */
+    Group openTag(const Referrer &referrer) const;
+
+    /**
+     * @brief Open the group of the feature of a referrer with Role::Feature.
+     */
+    Group openFeature(const Referrer &referrer) const;
+
+    /**
+     * @brief Add a reference of a tag to a data array.
+     */
+    void add(const std::string &array_id, const Referrer &referrer);
+
+
+    void remove(const std::string &array_id, const Referrer &referrer);
+
+    /**
+     * @brief Set the data array of a link that has at most one target,
+     *        i.e. the positions, extents or the data of a feature.
+     *
+     * @param referrer  The link.
+     * @param array_id  The new target; empty removes the link.
+     */
+    void set(const Referrer &referrer, const std::string &array_id);
+
+    /**
+     * @brief Set the data array of a feature that is only known by id.
+     */
+    void setFeatureData(const std::string &feature_id, const std::string &array_id);
+
+
+    void removeFeature(const std::string &feature_id);
+
+    /**
+     * @brief Remove all links of a deleted tag or multi-tag.
+     */
+    void removeTag(const std::string &tag_id);
+
+private:
+
+    void build() const;
+
+
+    void buildTags(const std::string &group_name, bool multi_tag) const;
+
+
+    void insert(const std::string &array_id, const Referrer &referrer) const;
+
+
+    static std::string slot(const Referrer &referrer);
+
+
+    Group                                                            block;
+
+    mutable bool                                                     built;
+    // referrers by data array id
+    mutable std::unordered_map<std::string, std::vector<Referrer>>   referrers;
+    // targets of the links with at most one target, see slot()
+    mutable std::unordered_map<std::string, std::string>             slots;
+    // ids of the data arrays each tag links to, possibly outdated ones
+    mutable std::unordered_map<std::string, std::unordered_set<std::string>> tag_arrays;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REFERENCE_INDEX_H
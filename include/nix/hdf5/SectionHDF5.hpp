@@ -69,6 +69,12 @@ public:
     // Attribute getter and setter
     //--------------------------------------------------
 
+    using NamedEntityHDF5::type;
+
+
+    void type(const std::string &type);
+
+
     void repository(const std::string &repository);
 
 
@@ -121,6 +127,15 @@ public:
     std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISection>> getSections(const util::Match &match) const;
+
+
+    std::vector<std::string> sectionKeys(const util::Match &match) const;
+
+
+    std::vector<std::shared_ptr<base::ISection>> findSections(const util::Match &match, size_t max_depth) const;
+
+
     std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
 
 
@@ -143,6 +158,12 @@ public:
     std::shared_ptr<base::IProperty> getProperty(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IProperty>> getProperties(const util::Match &match) const;
+
+
+    std::vector<std::string> propertyKeys(const util::Match &match) const;
+
+
     std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype);
 
 
@@ -11,6 +11,7 @@
 
 #include <nix/base/ISource.hpp>
 #include <nix/hdf5/EntityWithMetadataHDF5.hpp>
+#include <nix/hdf5/TreeIndex.hpp>
 
 #include <vector>
 #include <string>
@@ -28,6 +29,9 @@ private:
 
     optGroup source_group;
 
+    // the source index of the block of the source, or nullptr
+    TreeIndex *sourceIndex() const;
+
 public:
 
 
@@ -48,6 +52,12 @@ public:
     SourceHDF5(const std::shared_ptr<base::IFile> &file, const Group &group, const std::string &id, const std::string &type,
                const std::string &name, time_t time);
 
+
+    using NamedEntityHDF5::type;
+
+
+    void type(const std::string &type);
+
     //--------------------------------------------------
     // Methods concerning child sources
     //--------------------------------------------------
@@ -62,9 +72,18 @@ public:
     std::shared_ptr<base::ISource> getSource(ndsize_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> getSources(const util::Match &match) const;
+
+
+    std::vector<std::string> sourceKeys(const util::Match &match) const;
+
+
     ndsize_t sourceCount() const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> findSources(const util::Match &match, size_t max_depth) const;
+
+
     std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
 
 
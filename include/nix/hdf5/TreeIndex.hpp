@@ -0,0 +1,121 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TREE_INDEX_H
+#define NIX_TREE_INDEX_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/util/filter.hpp>
+#include <nix/Platform.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief In-memory index of a tree of entities that are stored as nested
+ *        groups, like the sections of a file.
+ *
+ * The roots of the tree are the groups in a base group, and the children
+ * of an entity are the groups in its subgroup with a fixed name (e.g.
+ * "sections"). The index maps ids to the position of the entities in the
+ * tree and names and types to ids, so that queries by id, name or type do
+ * not have to open the groups of the tree.
+ *
+ * The index is built in a single traversal on first use. Afterwards it is
+ * kept up to date by the entities through add(), remove() and retype(),
+ * which do nothing as long as the index has not been built.
+ */
+class NIXAPI TreeIndex {
+
+public:
+
+    struct Entry {
+        std::string              id;
+        std::string              name;
+        std::string              type;
+        std::string              parent;     //!< id of the parent; empty for roots
+        std::vector<std::string> path;       //!< link names from the root to the entity
+        std::vector<std::string> children;   //!< ids of the children
+
+        size_t depth() const {
+            return path.size() - 1;
+        }
+    };
+
+
+    TreeIndex(const Group &base, const std::string &children);
+
+
+    bool isBuilt() const {
+        return built;
+    }
+
+    /**
+     * @brief The entry of the entity with the given id, or nullptr.
+     */
+    const Entry *find(const std::string &id) const;
+
+    /**
+     * @brief The entries selected by a match, in breadth-first order.
+     *
+     * @param match     Selects by id, name or type.
+     * @param root      Only entries in the subtree of root, including root,
+     *                  are returned; nullptr selects the whole tree.
+     * @param max_depth The maximum depth relative to root, or to the roots
+     *                  of the tree.
+     */
+    std::vector<const Entry *> find(const util::Match &match, const Entry *root, size_t max_depth) const;
+
+    /**
+     * @brief Open the group of an entry.
+     */
+    Group open(const Entry &entry) const;
+
+    /**
+     * @brief Add a new entity below the entity parent, or as root if
+     *        parent is empty.
+     */
+    void add(const std::string &parent, const std::string &id, const std::string &name, const std::string &type);
+
+    /**
+     * @brief Remove an entity and all its descendants.
+     */
+    void remove(const std::string &id);
+
+
+    void retype(const std::string &id, const std::string &type);
+
+private:
+
+    void build() const;
+
+
+    void build(const Group &group, const std::string &name, const std::string &parent,
+               const std::vector<std::string> &parent_path) const;
+
+
+    void insert(Entry &&entry) const;
+
+
+    Group                                               base;
+    std::string                                         children;
+
+    mutable bool                                        built;
+    mutable std::unordered_map<std::string, Entry>      entries;
+    mutable std::unordered_multimap<std::string, std::string> by_name;
+    mutable std::unordered_multimap<std::string, std::string> by_type;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_TREE_INDEX_H
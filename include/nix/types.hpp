@@ -16,6 +16,7 @@ class Block;
 class Feature;
 class File;
 class DataArray;
+class DataAppender;
 class DataSet;
 class DataView;
 class Dimension;
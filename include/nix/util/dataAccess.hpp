@@ -16,6 +16,7 @@
 
 #include <nix/NDArray.hpp>
 #include <nix/DataView.hpp>
+#include <nix/DataSegments.hpp>
 #include <nix/Dimensions.hpp>
 #include <nix/DataArray.hpp>
 #include <nix/MultiTag.hpp>
@@ -94,6 +95,21 @@ NIXAPI void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &of
 
 NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index, NDSize &offsets, NDSize &counts);
 
+/**
+ * @brief Returns the offsets and element counts of all positions and extents of a MultiTag
+ *        in the referenced DataArray.
+ *
+ * Positions and extents are read at once and converted dimension by dimension, which
+ * is much cheaper than calling getOffsetAndCount for every position.
+ *
+ * @param tag           The multi tag.
+ * @param array         A referenced data array.
+ * @param[out] offsets  The offset of every position.
+ * @param[out] counts   The number of elements to read from data for every position.
+ */
+NIXAPI void getOffsetsAndCounts(const MultiTag &tag, const DataArray &array,
+                                std::vector<NDSize> &offsets, std::vector<NDSize> &counts);
+
 /**
  * @brief Retrieve the data referenced by the given position and extent of the MultiTag.
  *
@@ -105,6 +121,22 @@ NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_
  */
 NIXAPI DataView retrieveData(const MultiTag &tag, size_t position_index, size_t reference_index);
 
+/**
+ * @brief Retrieve the data referenced by several positions and extents of the MultiTag.
+ *
+ * The slices are read with as few I/O operations as possible and stored back to
+ * back in the order of position_indices; indices may repeat. Only numeric data
+ * is supported.
+ *
+ * @param tag                   The multi tag.
+ * @param position_indices      The indices of the positions.
+ * @param reference_index       The index of the reference from which data should be returned.
+ *
+ * @return The data referenced by the positions and extents.
+ */
+NIXAPI DataSegments retrieveDataBatch(const MultiTag &tag, const std::vector<size_t> &position_indices,
+                                      size_t reference_index);
+
 /**
  * @brief Retrieve the data referenced by the given position and extent of the Tag.
  *
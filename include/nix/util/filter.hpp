@@ -11,6 +11,8 @@
 #define NIX_FILTER_H
 
 #include <functional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <unordered_set>
 #include <string>
@@ -18,6 +20,57 @@
 namespace nix {
 namespace util {
 
+/**
+ * Declarative form of a filter on the name, id or type of an entity.
+ *
+ * Other than the filter functors a Match can be evaluated by the
+ * back-end before any entity is instantiated, e.g. by comparing the
+ * link names of a group. A Match with field "All" selects everything.
+ */
+struct Match {
+
+    enum class Field {All, Name, Id, Type};
+
+    Field field;
+
+    std::unordered_set<std::string> values;
+
+
+    Match()
+        : field(Field::All)
+    {}
+
+
+    Match(Field field, const std::vector<std::string> &values)
+        : field(field), values(values.begin(), values.end())
+    {}
+
+
+    bool accepts(const std::string &value) const {
+        return field == Field::All || values.count(value) > 0;
+    }
+
+    /**
+     * The same Match, but selecting everything instead of by type. The
+     * type is stored in every entity, so matching by it opens them all,
+     * while names and ids are looked up from links and indexes.
+     */
+    Match withoutType() const {
+        return field == Field::Type ? Match() : *this;
+    }
+
+    /**
+     * Obtain the Match of a type-erased filter. Filters without a
+     * declarative form yield a Match that selects everything, so
+     * the selected entities still have to be passed through the
+     * filter itself.
+     */
+    template<typename T>
+    static Match of(const std::function<bool(const T&)> &filter);
+
+};
+
+
 /**
  * Base struct to be inherited by all filter implementations.
  * Child classes will have to implement ()-operator and will
@@ -28,6 +81,10 @@ struct Filter : public std::unary_function<T, bool> {
 
     virtual bool operator()(const T&) = 0;
 
+    virtual Match match() const {
+        return Match();
+    }
+
     typedef std::function<bool(const T&)> type;
 
 };
@@ -63,6 +120,11 @@ struct IdFilter : public Filter<T> {
         return e.id() == id;
     }
 
+
+    Match match() const {
+        return Match(Match::Field::Id, {id});
+    }
+
 };
 
 
@@ -83,6 +145,11 @@ struct IdsFilter : public Filter<T> {
         return ids.count(e.id()) > 0;
     }
 
+
+    Match match() const {
+        return Match(Match::Field::Id, std::vector<std::string>(ids.begin(), ids.end()));
+    }
+
 };
 
 
@@ -101,6 +168,11 @@ struct TypeFilter : public Filter<T> {
         return e.type() == type;
     }
 
+
+    Match match() const {
+        return Match(Match::Field::Type, {type});
+    }
+
 };
 
 
@@ -119,9 +191,58 @@ struct NameFilter : public Filter<T> {
         return e.name() == name;
     }
 
+
+    Match match() const {
+        return Match(Match::Field::Name, {name});
+    }
+
 };
 
 
+template<typename T, typename = void>
+struct has_name : std::false_type {};
+
+template<typename T>
+struct has_name<T, decltype(void(std::declval<const T&>().name()))> : std::true_type {};
+
+
+template<typename T, typename = void>
+struct has_type : std::false_type {};
+
+template<typename T>
+struct has_type<T, decltype(void(std::declval<const T&>().type()))> : std::true_type {};
+
+
+// F is only instantiated if the entity type provides the field it filters on
+template<typename F, typename T>
+bool target_match(const std::function<bool(const T&)> &filter, Match &match, std::true_type) {
+    if (auto f = filter.template target<F>()) {
+        match = f->match();
+        return true;
+    }
+    return false;
+}
+
+
+template<typename F, typename T>
+bool target_match(const std::function<bool(const T&)> &filter, Match &match, std::false_type) {
+    return false;
+}
+
+
+template<typename T>
+Match Match::of(const std::function<bool(const T&)> &filter) {
+    Match match;
+
+    target_match<NameFilter<T>>(filter, match, has_name<T>()) ||
+    target_match<TypeFilter<T>>(filter, match, has_type<T>()) ||
+    target_match<IdFilter<T>>(filter, match, std::true_type()) ||
+    target_match<IdsFilter<T>>(filter, match, std::true_type());
+
+    return match;
+}
+
+
 } // namespace util
 } // namespace nix
 
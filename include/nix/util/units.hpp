@@ -0,0 +1,71 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_UNITS_H
+#define NIX_UNITS_H
+
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief An atomic SI unit, e.g. "mV^-2", split into its components.
+ */
+struct NIXAPI AtomicUnit {
+    std::string prefix;     //!< the SI prefix, e.g. "m"; empty if there is none
+    std::string unit;       //!< the base unit, e.g. "V"
+    std::string power;      //!< the power as written, e.g. "-2"; empty if there is none
+    int         exponent;   //!< the power as number, 1 if there is none
+    double      factor;     //!< the factor of the prefix, 1 if there is none
+};
+
+/**
+ * @brief A unit string parsed into atomic SI units that are joined by "*"
+ *        or "/".
+ *
+ * A string that is neither an atomic nor a compound SI unit has no terms.
+ */
+struct NIXAPI Unit {
+    std::string             name;           //!< the parsed string
+    std::vector<AtomicUnit> terms;
+    std::vector<char>       separators;     //!< separators[i] is the separator between terms i and i + 1
+
+    bool isSI() const {
+        return !terms.empty();
+    }
+
+    bool isAtomic() const {
+        return terms.size() == 1;
+    }
+
+    bool isCompound() const {
+        return terms.size() > 1;
+    }
+};
+
+/**
+ * @brief Parse a unit string.
+ *
+ * The parsed units are kept in a cache, so repeated calls with the same
+ * string are cheap. The string is parsed as is, it is not sanitized.
+ *
+ * @param unit  The unit string, e.g. "mV^2*Hz^-1".
+ *
+ * @return The parsed unit.
+ */
+NIXAPI std::shared_ptr<const Unit> parseUnit(const std::string &unit);
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_UNITS_H
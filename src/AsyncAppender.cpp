@@ -0,0 +1,287 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/AsyncAppender.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nix {
+
+// how long the threads sleep before they check the ring buffer again
+// in case a notification was missed
+static const std::chrono::milliseconds POLL_INTERVAL(1);
+
+
+AsyncAppender::AsyncAppender(const DataArray &array, size_t axis, size_t capacity, Backpressure policy)
+    : array(array), axis(axis), policy(policy), ring(std::max<size_t>(capacity, 1)), head(0), tail(0),
+      spill_file(nullptr), spill_read(0), spill_write(0), spilling(false), enqueued(0), written(0),
+      dropped(0), spilled(0), stop(false), failed(false)
+{
+    for (auto &bucket : latency) {
+        bucket = 0;
+    }
+
+    if (axis >= this->array.dataExtent().size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    writer = std::thread(&AsyncAppender::run, this);
+}
+
+
+bool AsyncAppender::append(DataType dtype, const void *data, const NDSize &count) {
+    rethrow();
+
+    if (stop) {
+        throw std::runtime_error("AsyncAppender::append: appender is closed");
+    }
+
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("AsyncAppender::append: strings can not be queued");
+    }
+
+    const size_t nbytes = check::fits_in_size_t(count.nelms() * data_type_to_size(dtype),
+                                                 "AsyncAppender::append: block exceeds memory");
+    const char *bytes = static_cast<const char *>(data);
+    const auto now = std::chrono::steady_clock::now();
+
+    // once blocks have been spilled all later ones have to follow them
+    // through the spill file, otherwise they would overtake them
+    if (!spilling) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        bool full = t - head.load(std::memory_order_acquire) >= ring.size();
+
+        if (full && policy == Backpressure::Drop) {
+            dropped++;
+            return false;
+        }
+
+        if (full && policy == Backpressure::Block) {
+            std::unique_lock<std::mutex> lock(wait_mutex);
+            while (t - head.load(std::memory_order_acquire) >= ring.size()) {
+                rethrow();
+                wake_producer.wait_for(lock, POLL_INTERVAL);
+            }
+            full = false;
+        }
+
+        if (!full) {
+            Block &slot = ring[t % ring.size()];
+            slot.dtype = dtype;
+            slot.count = count;
+            slot.data.assign(bytes, bytes + nbytes);
+            slot.queued = now;
+
+            enqueued++;
+            tail.store(t + 1, std::memory_order_release);
+            wake_writer.notify_one();
+            return true;
+        }
+    }
+
+    Block block;
+    block.dtype = dtype;
+    block.count = count;
+    block.data.assign(bytes, bytes + nbytes);
+    block.queued = now;
+
+    spill(block);
+
+    enqueued++;
+    spilled++;
+    wake_writer.notify_one();
+    return true;
+}
+
+
+void AsyncAppender::flush() {
+    const size_t target = enqueued;
+
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    while (written < target && !failed) {
+        wake_writer.notify_one();
+        wake_producer.wait_for(lock, POLL_INTERVAL);
+    }
+
+    rethrow();
+}
+
+
+void AsyncAppender::close() {
+    if (writer.joinable()) {
+        stop = true;
+        wake_writer.notify_one();
+        writer.join();
+    }
+
+    if (spill_file != nullptr) {
+        std::fclose(spill_file);
+        spill_file = nullptr;
+    }
+
+    rethrow();
+}
+
+
+AsyncAppender::Stats AsyncAppender::stats() const {
+    Stats s;
+    s.enqueued = enqueued;
+    s.written = written;
+    s.dropped = dropped;
+    s.spilled = spilled;
+
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+        s.latency[i] = latency[i];
+    }
+
+    return s;
+}
+
+
+void AsyncAppender::run() {
+    try {
+        while (true) {
+            const size_t h = head.load(std::memory_order_relaxed);
+
+            if (h != tail.load(std::memory_order_acquire)) {
+                write(ring[h % ring.size()]);
+                head.store(h + 1, std::memory_order_release);
+                wake_producer.notify_all();
+                continue;
+            }
+
+            if (spilling) {
+                Block block;
+                if (unspill(block)) {
+                    write(block);
+                    wake_producer.notify_all();
+                    continue;
+                }
+            }
+
+            if (stop && head.load() == tail.load() && !spilling) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(wait_mutex);
+            wake_writer.wait_for(lock, POLL_INTERVAL);
+        }
+    } catch (...) {
+        error = std::current_exception();
+        failed = true;
+        wake_producer.notify_all();
+    }
+}
+
+
+bool AsyncAppender::spill(const Block &block) {
+    std::lock_guard<std::mutex> lock(spill_mutex);
+
+    if (spill_file == nullptr) {
+        spill_file = std::tmpfile();
+        if (spill_file == nullptr) {
+            throw std::runtime_error("AsyncAppender: could not create spill file");
+        }
+    }
+
+    const int dtype = static_cast<int>(block.dtype);
+    const size_t rank = block.count.size();
+    const size_t nbytes = block.data.size();
+    const auto queued = block.queued.time_since_epoch().count();
+
+    bool ok = std::fseek(spill_file, spill_write, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&dtype, sizeof(dtype), 1, spill_file) == 1;
+    ok = ok && std::fwrite(&rank, sizeof(rank), 1, spill_file) == 1;
+    ok = ok && (rank == 0 || std::fwrite(block.count.data(), sizeof(ndsize_t), rank, spill_file) == rank);
+    ok = ok && std::fwrite(&queued, sizeof(queued), 1, spill_file) == 1;
+    ok = ok && std::fwrite(&nbytes, sizeof(nbytes), 1, spill_file) == 1;
+    ok = ok && (nbytes == 0 || std::fwrite(block.data.data(), 1, nbytes, spill_file) == nbytes);
+
+    if (!ok) {
+        throw std::runtime_error("AsyncAppender: could not write to spill file");
+    }
+
+    spill_write = std::ftell(spill_file);
+    spilling = true;
+    return true;
+}
+
+
+bool AsyncAppender::unspill(Block &block) {
+    std::lock_guard<std::mutex> lock(spill_mutex);
+
+    if (spill_read >= spill_write) {
+        // everything has been written, start over at the beginning
+        spill_read = spill_write = 0;
+        spilling = false;
+        return false;
+    }
+
+    int dtype;
+    size_t rank, nbytes;
+    std::chrono::steady_clock::duration::rep queued;
+
+    bool ok = std::fseek(spill_file, spill_read, SEEK_SET) == 0;
+    ok = ok && std::fread(&dtype, sizeof(dtype), 1, spill_file) == 1;
+    ok = ok && std::fread(&rank, sizeof(rank), 1, spill_file) == 1;
+    if (ok) {
+        block.count = NDSize(rank);
+        ok = rank == 0 || std::fread(block.count.data(), sizeof(ndsize_t), rank, spill_file) == rank;
+    }
+    ok = ok && std::fread(&queued, sizeof(queued), 1, spill_file) == 1;
+    ok = ok && std::fread(&nbytes, sizeof(nbytes), 1, spill_file) == 1;
+    if (ok) {
+        block.data.resize(nbytes);
+        ok = nbytes == 0 || std::fread(block.data.data(), 1, nbytes, spill_file) == nbytes;
+    }
+
+    if (!ok) {
+        throw std::runtime_error("AsyncAppender: could not read from spill file");
+    }
+
+    block.dtype = static_cast<DataType>(dtype);
+    block.queued = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(queued));
+    spill_read = std::ftell(spill_file);
+    return true;
+}
+
+
+void AsyncAppender::write(const Block &block) {
+    array.appendData(block.dtype, block.data.data(), block.count, axis);
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - block.queued).count();
+
+    size_t bucket = 0;
+    while (us > 1 && bucket < LATENCY_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+
+    latency[bucket]++;
+    written++;
+}
+
+
+void AsyncAppender::rethrow() const {
+    if (failed) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+AsyncAppender::~AsyncAppender() {
+    try {
+        close();
+    } catch (...) {
+        // destructors must not throw
+    }
+}
+
+} // namespace nix
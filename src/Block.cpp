@@ -23,6 +23,13 @@ Source Block::createSource(const std::string &name, const std::string &type){
 
 std::vector<Source> Block::findSources(const util::Filter<Source>::type &filter,
         size_t max_depth) const {
+
+    // filters on id, name or type are answered by the source index
+    util::Match match = util::Match::of(filter);
+    if (match.field != util::Match::Field::All) {
+        return getEntities<Source>(backend()->findSources(match, max_depth), filter);
+    }
+
     const vector<Source> probes = sources();
     vector<Source> matches;
     vector<Source> result;
@@ -41,10 +48,15 @@ bool Block::hasSource(const Source &source) const {
 }
 
 std::vector<Source> Block::sources(const util::Filter<Source>::type &filter) const {
-    auto f = [this](ndsize_t i) { return getSource(i); };
-    return getEntities<Source>(f,
-            sourceCount(),
-            filter);
+    return getEntities<Source>(backend()->getSources(util::Match::of(filter)),
+                               filter);
+}
+
+EntityRange<Source> Block::sourceRange(const util::Filter<Source>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Source>(container->sourceKeys(util::Match::of(filter).withoutType()),
+                               [container](const std::string &key) { return Source(container->getSource(key)); },
+                               filter);
 }
 
 bool Block::deleteSource(const Source &source) {
@@ -53,12 +65,17 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape) {
+                                 const NDSize &shape, const Compression &compression,
+                                 const Chunking &chunking) {
     util::checkEntityNameAndType(name, type);
     if (backend()->hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape);
+    NDSize chunks;
+    if (chunking.hasHints()) {
+        chunks = chunking.chunkShape(shape, data_type_to_size(data_type));
+    }
+    return backend()->createDataArray(name, type, data_type, shape, compression, chunks);
 }
 
 bool Block::hasDataArray(const DataArray &data_array) const {
@@ -67,9 +84,14 @@ bool Block::hasDataArray(const DataArray &data_array) const {
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getDataArray(i); };
-    return getEntities<DataArray>(f,
-                                  dataArrayCount(),
+    return getEntities<DataArray>(backend()->getDataArrays(util::Match::of(filter)),
+                                  filter);
+}
+
+EntityRange<DataArray> Block::dataArrayRange(const util::Filter<DataArray>::type &filter) const {
+    auto container = impl();
+    return EntityRange<DataArray>(container->dataArrayKeys(util::Match::of(filter).withoutType()),
+                                  [container](const std::string &key) { return DataArray(container->getDataArray(key)); },
                                   filter);
 }
 
@@ -92,9 +114,14 @@ bool Block::hasTag(const Tag &tag) const {
 }
 
 std::vector<Tag> Block::tags(const util::Filter<Tag>::type &filter) const {
-    auto f = [this] (ndsize_t i) { return getTag(i); };
-    return getEntities<Tag>(f,
-                            tagCount(),
+    return getEntities<Tag>(backend()->getTags(util::Match::of(filter)),
+                            filter);
+}
+
+EntityRange<Tag> Block::tagRange(const util::Filter<Tag>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Tag>(container->tagKeys(util::Match::of(filter).withoutType()),
+                            [container](const std::string &key) { return Tag(container->getTag(key)); },
                             filter);
 }
 
@@ -118,12 +145,17 @@ bool Block::hasMultiTag(const MultiTag &multi_tag) const {
 }
 
 std::vector<MultiTag> Block::multiTags(const util::AcceptAll<MultiTag>::type &filter) const {
-    auto f = [this] (ndsize_t i) { return getMultiTag(i); };
-    return getEntities<MultiTag>(f,
-                                multiTagCount(),
+    return getEntities<MultiTag>(backend()->getMultiTags(util::Match::of(filter)),
                                 filter);
 }
 
+EntityRange<MultiTag> Block::multiTagRange(const util::Filter<MultiTag>::type &filter) const {
+    auto container = impl();
+    return EntityRange<MultiTag>(container->multiTagKeys(util::Match::of(filter).withoutType()),
+                                 [container](const std::string &key) { return MultiTag(container->getMultiTag(key)); },
+                                 filter);
+}
+
 bool Block::deleteMultiTag(const MultiTag &multi_tag) {
     util::checkEntityInput(multi_tag);
     return backend()->deleteMultiTag(multi_tag.id());
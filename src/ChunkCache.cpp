@@ -0,0 +1,64 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/ChunkCache.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+
+static bool is_prime(size_t n) {
+    if (n < 2) {
+        return false;
+    }
+
+    for (size_t d = 2; d * d <= n; d++) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static size_t next_prime(size_t n) {
+    while (!is_prime(n)) {
+        n++;
+    }
+    return n;
+}
+
+
+ChunkCache ChunkCache::forAccess(const NDSize &chunks, size_t element_size, const NDSize &access) {
+    ChunkCache cache;
+
+    if (chunks.size() == 0 || chunks.size() != access.size() || chunks.nelms() == 0) {
+        return cache;
+    }
+
+    // number of chunks a block of shape access at an arbitrary offset
+    // can touch, and whether every access covers whole chunks only
+    ndsize_t touched = 1;
+    bool whole_chunks = true;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        ndsize_t a = std::max<ndsize_t>(access[i], 1);
+        touched *= (a + chunks[i] - 2) / chunks[i] + 1;
+        whole_chunks = whole_chunks && (a % chunks[i] == 0);
+    }
+
+    ndsize_t chunk_bytes = chunks.nelms() * element_size;
+    cache.bytes = std::max<size_t>(cache.bytes, static_cast<size_t>(touched * chunk_bytes));
+    cache.slots = next_prime(std::max<size_t>(cache.slots, static_cast<size_t>(touched * 100)));
+    cache.preemption = whole_chunks ? 1.0 : cache.preemption;
+
+    return cache;
+}
+
+} // namespace nix
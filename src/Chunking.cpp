@@ -0,0 +1,94 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Chunking.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+
+NDSize Chunking::chunkShape(const NDSize &shape, size_t element_size) const {
+    const size_t rank = shape.size();
+
+    if (!hasHints() || rank == 0) {
+        return NDSize{};
+    }
+
+    if (chunks.size() > 0) {
+        if (chunks.size() != rank) {
+            throw IncompatibleDimensions("Chunks and data must have the same dimensionality", "Chunking::chunkShape");
+        }
+        return chunks;
+    }
+
+    if ((growth_axis && *growth_axis >= rank) || (read_axis && *read_axis >= rank)) {
+        throw InvalidRank("Chunking::chunkShape: axis is out of bounds");
+    }
+
+    if (access.size() > 0 && access.size() != rank) {
+        throw IncompatibleDimensions("Access and data must have the same dimensionality", "Chunking::chunkShape");
+    }
+
+    const ndsize_t target = std::max<ndsize_t>(1, target_bytes / std::max<size_t>(element_size, 1));
+
+    // the axis that receives whatever volume is left of the target
+    const size_t primary = read_axis ? *read_axis : (growth_axis ? *growth_axis : 0);
+
+    // upper bound of the chunk along an axis, 0 if unbounded
+    auto limit = [&](size_t d) -> ndsize_t {
+        bool grows = growth_axis && *growth_axis == d;
+        return grows ? 0 : shape[d];
+    };
+
+    NDSize c(rank, 1);
+    for (size_t d = 0; d < rank; d++) {
+        if (access.size() > 0) {
+            c[d] = std::max<ndsize_t>(access[d], 1);
+        } else if (d == primary || read_axis) {
+            // reads along the read axis touch a single chunk per position
+            // on the other axes if those are as narrow as possible
+            c[d] = 1;
+        } else {
+            // appends write whole rows, keep them inside one chunk
+            c[d] = std::max<ndsize_t>(limit(d), 1);
+        }
+
+        if (limit(d) > 0 && c[d] > limit(d)) {
+            c[d] = limit(d);
+        }
+    }
+
+    // shrink the secondary axes first if they alone exceed the target
+    while (c.nelms() > target) {
+        size_t largest = primary;
+        for (size_t d = 0; d < rank; d++) {
+            if (d != primary && c[d] > 1 && (largest == primary || c[d] > c[largest])) {
+                largest = d;
+            }
+        }
+
+        if (c[largest] == 1) {
+            break;
+        }
+
+        c[largest] = (c[largest] + 1) / 2;
+    }
+
+    ndsize_t others = c.nelms() / c[primary];
+    ndsize_t length = std::max<ndsize_t>(c[primary], target / others);
+    if (limit(primary) > 0) {
+        length = std::min<ndsize_t>(length, limit(primary));
+    }
+    c[primary] = std::max<ndsize_t>(length, 1);
+
+    return c;
+}
+
+} // namespace nix
@@ -0,0 +1,199 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataAppender.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace nix {
+
+
+DataAppender::DataAppender(const DataArray &array, size_t axis, size_t buffer_bytes)
+    : array(array), axis(axis), dtype(DataType::Nothing), buffer_size(buffer_bytes), outer(1),
+      row_bytes(0), chunk_rows(1), capacity(0), buffered(0), written(0), allocated(0), open(true)
+{
+    NDSize extent = this->array.dataExtent();
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    written = allocated = extent[axis];
+    shape = extent;
+    shape[axis] = 1;
+
+    for (size_t i = 0; i < axis; i++) {
+        outer *= extent[i];
+    }
+
+    NDSize chunks = this->array.dataChunks();
+    if (chunks.size() > axis && chunks[axis] > 0) {
+        chunk_rows = chunks[axis];
+    }
+}
+
+
+DataAppender::DataAppender(DataAppender &&other)
+    : array(other.array), axis(other.axis), dtype(other.dtype), buffer_size(other.buffer_size),
+      shape(other.shape), outer(other.outer), row_bytes(other.row_bytes), chunk_rows(other.chunk_rows),
+      capacity(other.capacity), buffered(other.buffered), written(other.written),
+      allocated(other.allocated), buffer(std::move(other.buffer)), open(other.open)
+{
+    other.open = false;
+    other.buffered = 0;
+}
+
+
+void DataAppender::append(DataType dtype, const void *data, const NDSize &count) {
+    if (!open) {
+        throw std::runtime_error("DataAppender::append: appender is closed");
+    }
+
+    if (count.size() != shape.size()) {
+        throw IncompatibleDimensions("Data and DataArray must have the same dimensionality", "DataAppender::append");
+    }
+
+    for (size_t i = 0; i < count.size(); i++) {
+        if (i != axis && count[i] != shape[i]) {
+            throw IncompatibleDimensions("Shape of data and shape of DataArray must match in all dimension but axis!",
+                                         "DataAppender::append");
+        }
+    }
+
+    if (this->dtype == DataType::Nothing) {
+        if (dtype == DataType::String) {
+            throw std::invalid_argument("DataAppender::append: strings can not be buffered");
+        }
+
+        this->dtype = dtype;
+        row_bytes = check::fits_in_size_t(shape.nelms() / std::max<ndsize_t>(outer, 1) * data_type_to_size(dtype),
+                                          "DataAppender::append: row size exceeds memory");
+
+        // the buffer holds whole chunks along the axis, at least one
+        ndsize_t rows = buffer_size / std::max<ndsize_t>(row_bytes * outer, 1);
+        capacity = std::max<ndsize_t>(rows / chunk_rows * chunk_rows, chunk_rows);
+        buffer.resize(check::fits_in_size_t(capacity * outer * row_bytes,
+                                            "DataAppender::append: buffer exceeds memory"));
+    } else if (dtype != this->dtype) {
+        throw std::invalid_argument("DataAppender::append: data type must be the same for all blocks");
+    }
+
+    const ndsize_t n = count[axis];
+    if (n == 0) {
+        return;
+    }
+
+    if (n > capacity - buffered) {
+        flush();
+
+        // blocks that do not fit into the buffer go to the file directly
+        if (n >= capacity) {
+            write(static_cast<const char *>(data), count, n);
+            return;
+        }
+    }
+
+    const char *src = static_cast<const char *>(data);
+    for (ndsize_t o = 0; o < outer; o++) {
+        std::memcpy(buffer.data() + (o * capacity + buffered) * row_bytes,
+                    src + o * n * row_bytes,
+                    n * row_bytes);
+    }
+
+    buffered += n;
+
+    if (buffered == capacity) {
+        flush();
+    }
+}
+
+
+void DataAppender::flush() {
+    if (buffered == 0) {
+        return;
+    }
+
+    // the blocks of the outer dimensions are capacity rows apart in the
+    // buffer, move them together if the buffer is not full
+    if (outer > 1 && buffered < capacity) {
+        for (ndsize_t o = 1; o < outer; o++) {
+            std::memmove(buffer.data() + o * buffered * row_bytes,
+                         buffer.data() + o * capacity * row_bytes,
+                         buffered * row_bytes);
+        }
+    }
+
+    NDSize count = shape;
+    count[axis] = buffered;
+    write(buffer.data(), count, buffered);
+    buffered = 0;
+}
+
+
+void DataAppender::close() {
+    if (!open) {
+        return;
+    }
+
+    flush();
+
+    if (allocated != written) {
+        NDSize extent = shape;
+        extent[axis] = written;
+        array.dataExtent(extent);
+        allocated = written;
+    }
+
+    open = false;
+    std::vector<char>().swap(buffer);
+}
+
+
+void DataAppender::write(const char *data, const NDSize &count, ndsize_t rows) {
+    reserve(written + rows);
+
+    NDSize offset(shape.size(), 0);
+    offset[axis] = written;
+
+    array.setData(dtype, data, count, offset);
+    written += rows;
+}
+
+
+void DataAppender::reserve(ndsize_t rows) {
+    if (rows <= allocated) {
+        return;
+    }
+
+    // grow geometrically and in whole chunks
+    ndsize_t grow = std::max(rows, allocated * 2);
+    grow = (grow + chunk_rows - 1) / chunk_rows * chunk_rows;
+
+    NDSize extent = shape;
+    extent[axis] = grow;
+    array.dataExtent(extent);
+    allocated = grow;
+}
+
+
+DataAppender::~DataAppender() {
+    try {
+        close();
+    } catch (...) {
+        // destructors must not throw
+    }
+}
+
+
+DataAppender DataArray::appender(size_t axis, size_t buffer_bytes) {
+    return DataAppender(*this, axis, buffer_bytes);
+}
+
+} // namespace nix
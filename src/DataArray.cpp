@@ -7,11 +7,17 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/DataArray.hpp>
+#include <nix/Tag.hpp>
+#include <nix/MultiTag.hpp>
+#include <nix/Feature.hpp>
 
 #include <nix/util/util.hpp>
 #include <nix/hdf5/DataTypeHDF5.hpp>
 
 #include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 using namespace nix;
 
@@ -25,38 +31,179 @@ static void convertData(DataType source, DataType destination, void *data, size_
 }
 
 
-void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+// values converted and calibrated at once
+static const size_t CALIBRATION_BLOCK = 1024;
+
+typedef void (*load_fn)(const char *, size_t, double *);
+typedef void (*store_fn)(const double *, size_t, char *);
+
+
+template<typename T>
+static void loadBlock(const char *src, size_t n, double *dst) {
+    T values[CALIBRATION_BLOCK];
+    memcpy(values, src, n * sizeof(T));
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = static_cast<double>(values[i]);
+    }
+}
+
+
+// truncate towards zero and saturate, like the conversions of HDF5
+template<typename T>
+static typename std::enable_if<std::is_integral<T>::value, T>::type fromDouble(double value) {
+    const double lowest = static_cast<double>(std::numeric_limits<T>::min());
+    const double highest = static_cast<double>(std::numeric_limits<T>::max());
+
+    if (value >= highest) {
+        return std::numeric_limits<T>::max();
+    }
+    return value >= lowest ? static_cast<T>(value) : std::numeric_limits<T>::min();
+}
+
+
+template<typename T>
+static typename std::enable_if<std::is_floating_point<T>::value, T>::type fromDouble(double value) {
+    return static_cast<T>(value);
+}
+
+
+template<typename T>
+static void storeBlock(const double *src, size_t n, char *dst) {
+    T values[CALIBRATION_BLOCK];
+    for (size_t i = 0; i < n; i++) {
+        values[i] = fromDouble<T>(src[i]);
+    }
+    memcpy(dst, values, n * sizeof(T));
+}
+
+
+static load_fn blockLoader(DataType dtype) {
+    switch (dtype) {
+    case DataType::Int8:   return loadBlock<int8_t>;
+    case DataType::UInt8:  return loadBlock<uint8_t>;
+    case DataType::Int16:  return loadBlock<int16_t>;
+    case DataType::UInt16: return loadBlock<uint16_t>;
+    case DataType::Int32:  return loadBlock<int32_t>;
+    case DataType::UInt32: return loadBlock<uint32_t>;
+    case DataType::Int64:  return loadBlock<int64_t>;
+    case DataType::UInt64: return loadBlock<uint64_t>;
+    case DataType::Float:  return loadBlock<float>;
+    case DataType::Double: return loadBlock<double>;
+    default:
+        throw std::invalid_argument("DataType is not numeric");
+    }
+}
+
+
+static store_fn blockStorer(DataType dtype) {
+    switch (dtype) {
+    case DataType::Int8:   return storeBlock<int8_t>;
+    case DataType::UInt8:  return storeBlock<uint8_t>;
+    case DataType::Int16:  return storeBlock<int16_t>;
+    case DataType::UInt16: return storeBlock<uint16_t>;
+    case DataType::Int32:  return storeBlock<int32_t>;
+    case DataType::UInt32: return storeBlock<uint32_t>;
+    case DataType::Int64:  return storeBlock<int64_t>;
+    case DataType::UInt64: return storeBlock<uint64_t>;
+    case DataType::Float:  return storeBlock<float>;
+    case DataType::Double: return storeBlock<double>;
+    default:
+        throw std::invalid_argument("DataType is not numeric");
+    }
+}
+
+
+// Converts nelms values of type source at the start of data to double,
+// applies the polynomial and stores them as destination. The elements of
+// destination must not be smaller than those of source: the blocks are
+// processed from the back, so every block only overwrites source values
+// that have already been loaded.
+static void calibrateInPlace(DataType source, DataType destination, const std::vector<double> &poly,
+                             double origin, void *data, size_t nelms) {
+    const load_fn load = blockLoader(source);
+    const store_fn store = blockStorer(destination);
+    const size_t src_esize = data_type_to_size(source);
+    const size_t dst_esize = data_type_to_size(destination);
+
+    char *bytes = static_cast<char *>(data);
+    double block[CALIBRATION_BLOCK];
+
+    for (size_t end = nelms; end > 0;) {
+        const size_t n = std::min(end, CALIBRATION_BLOCK);
+        const size_t begin = end - n;
+
+        load(bytes + begin * src_esize, n, block);
+        util::applyPolynomial(poly, origin, block, block, n);
+        store(block, n, bytes + begin * dst_esize);
+
+        end = begin;
+    }
+}
+
+
+void DataArray::readCalibrated(DataType dtype, void *data, ndsize_t count,
+                               const std::function<void(DataType, void *)> &reader) const {
     const std::vector<double> poly = polynomCoefficients();
     boost::optional<double> opt_origin = expansionOrigin();
 
-    if (poly.size() || opt_origin) {
-        size_t data_esize = data_type_to_size(dtype);
-        size_t nelms = check::fits_in_size_t(count.nelms(),
-			"Cannot apply polynom or oirign transform. Buffer needed exceeds memory.");
-        std::vector<double> tmp;
-        double *read_buffer;
-
-        if (data_esize < sizeof(double)) {
-            //need temporary buffer
-            tmp.resize(nelms);
-            read_buffer = tmp.data();
-        } else {
-            read_buffer = reinterpret_cast<double *>(data);
-        }
-
-        getDataDirect(DataType::Double, read_buffer, count, offset);
-        const double origin = opt_origin ? *opt_origin : 0.0;
+    if (!(poly.size() || opt_origin)) {
+        reader(dtype, data);
+        return;
+    }
 
-        util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
-        convertData(DataType::Double, dtype, read_buffer, nelms);
+    size_t data_esize = data_type_to_size(dtype);
+    size_t nelms = check::fits_in_size_t(count,
+        "Cannot apply polynom or oirign transform. Buffer needed exceeds memory.");
+    const double origin = opt_origin ? *opt_origin : 0.0;
+    const DataType stored = dataType();
+
+    if (data_type_is_numeric(dtype) && data_type_is_numeric(stored) && data_type_to_size(stored) <= data_esize) {
+        // the stored values fit into the buffer, they are read as they are
+        // and converted and calibrated there
+        reader(stored, data);
+        calibrateInPlace(stored, dtype, poly, origin, data, nelms);
+        return;
+    }
 
-        if (tmp.size()) {
-            memcpy(data, read_buffer, nelms * data_esize);
-        }
+    std::vector<double> tmp;
+    double *read_buffer;
 
+    if (data_esize < sizeof(double)) {
+        //need temporary buffer
+        tmp.resize(nelms);
+        read_buffer = tmp.data();
     } else {
-        getDataDirect(dtype, data, count, offset);
+        read_buffer = reinterpret_cast<double *>(data);
     }
+
+    reader(DataType::Double, read_buffer);
+
+    util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
+    convertData(DataType::Double, dtype, read_buffer, nelms);
+
+    if (tmp.size()) {
+        memcpy(data, read_buffer, nelms * data_esize);
+    }
+}
+
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    readCalibrated(dtype, data, count.nelms(), [&](DataType read_type, void *buffer) {
+        getDataDirect(read_type, buffer, count, offset);
+    });
+}
+
+
+void DataArray::getDataSegments(DataType dtype, void *data,
+                                const std::vector<NDSize> &offsets, const std::vector<NDSize> &counts) const {
+    ndsize_t total = 0;
+    for (const NDSize &count : counts) {
+        total += count.nelms();
+    }
+
+    readCalibrated(dtype, data, total, [&](DataType read_type, void *buffer) {
+        backend()->readSegments(read_type, buffer, offsets, counts);
+    });
 }
 
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
@@ -98,6 +245,32 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
 
 }
 
+void DataArray::chunkCacheFor(const NDSize &access) {
+    NDSize chunks = dataChunks();
+
+    if (chunks.size() == 0) {
+        return; // contiguous data is not cached
+    }
+
+    if (chunks.size() != access.size()) {
+        throw IncompatibleDimensions("Access pattern and data must have the same dimensionality", "chunkCacheFor");
+    }
+
+    chunkCache(ChunkCache::forAccess(chunks, data_type_to_size(dataType()), access));
+}
+
+std::vector<Tag> DataArray::referringTags(const util::Filter<Tag>::type &filter) const {
+    return getEntities<Tag>(backend()->referringTags(), filter);
+}
+
+std::vector<MultiTag> DataArray::referringMultiTags(const util::Filter<MultiTag>::type &filter) const {
+    return getEntities<MultiTag>(backend()->referringMultiTags(), filter);
+}
+
+std::vector<Feature> DataArray::referringFeatures() const {
+    return getEntities<Feature>(backend()->referringFeatures(), util::AcceptAll<Feature>());
+}
+
 void DataArray::unit(const std::string &unit) {
     util::checkEmptyString(unit, "unit");
     if (!unit.empty() && !(util::isSIUnit(unit) || util::isCompoundSIUnit(unit))) {
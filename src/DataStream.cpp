@@ -0,0 +1,213 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataStream.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace nix {
+
+static const size_t NO_BUFFER = std::numeric_limits<size_t>::max();
+
+
+DataStream::DataStream(const DataArray &array, DataType dtype, size_t read_ahead, size_t block_bytes)
+    : array(array), dtype(dtype), count(array.dataExtent())
+{
+    offset = NDSize(count.size(), 0);
+    init(read_ahead, block_bytes);
+}
+
+
+DataStream::DataStream(const DataView &view, DataType dtype, size_t read_ahead, size_t block_bytes)
+    : array(view.array), dtype(dtype), offset(view.offset), count(view.count)
+{
+    init(read_ahead, block_bytes);
+}
+
+
+void DataStream::init(size_t read_ahead, size_t block_bytes) {
+    if (!(data_type_is_numeric(dtype) || dtype == DataType::Bool)) {
+        throw std::invalid_argument("DataStream: data type must have a fixed size");
+    }
+
+    nblocks = 0;
+    position = 0;
+    current_buffer = NO_BUFFER;
+    current.dtype = dtype;
+    current.buffer = nullptr;
+    stop = false;
+
+    const size_t rank = count.size();
+    if (rank == 0 || count.nelms() == 0) {
+        return;
+    }
+
+    NDSize chunks = array.dataChunks();
+    if (chunks.size() != rank) {
+        // contiguous data
+        chunks = NDSize(rank, 1);
+    }
+
+    // The blocks start at the chunk boundary before the region and have a
+    // pitch of a multiple of the chunk size. Starting with one chunk, the
+    // pitch is grown along the fastest varying dimensions until a block
+    // holds the requested number of elements or covers the region.
+    const ndsize_t target = std::max<ndsize_t>(block_bytes / data_type_to_size(dtype), 1);
+    NDSize base(rank), pitch(rank);
+    shape = NDSize(rank);
+
+    for (size_t d = 0; d < rank; d++) {
+        base[d] = offset[d] - offset[d] % chunks[d];
+        pitch[d] = chunks[d];
+        shape[d] = std::min(pitch[d], count[d]);
+    }
+
+    ndsize_t elms = shape.nelms();
+    for (size_t d = rank; d-- > 0 && elms < target;) {
+        const ndsize_t others = elms / shape[d];
+        const ndsize_t cover = offset[d] - base[d] + count[d];
+        const ndsize_t wanted = (target + others - 1) / others;
+
+        pitch[d] = std::min((wanted + chunks[d] - 1) / chunks[d], (cover + chunks[d] - 1) / chunks[d]) * chunks[d];
+        shape[d] = std::min(pitch[d], count[d]);
+        elms = others * shape[d];
+    }
+
+    tiles.resize(rank);
+    nblocks = 1;
+    for (size_t d = 0; d < rank; d++) {
+        tiles[d].push_back(0);
+        for (ndsize_t start = base[d] + pitch[d]; start < offset[d] + count[d]; start += pitch[d]) {
+            tiles[d].push_back(start - offset[d]);
+        }
+        nblocks *= tiles[d].size();
+    }
+
+    const size_t nbytes = check::fits_in_size_t(elms * data_type_to_size(dtype),
+                                                "DataStream: block exceeds memory");
+    pool.resize(read_ahead + 1, std::vector<char>(nbytes));
+
+    if (read_ahead > 0) {
+        for (size_t i = 0; i < pool.size(); i++) {
+            free_buffers.push_back(i);
+        }
+        reader = std::thread(&DataStream::run, this);
+    }
+}
+
+
+void DataStream::blockAt(size_t index, NDSize &block_offset, NDSize &block_count) const {
+    const size_t rank = count.size();
+    block_offset = NDSize(rank);
+    block_count = NDSize(rank);
+
+    for (size_t d = rank; d-- > 0;) {
+        const std::vector<ndsize_t> &starts = tiles[d];
+        const size_t i = index % starts.size();
+        index /= starts.size();
+
+        block_offset[d] = starts[i];
+        block_count[d] = (i + 1 < starts.size() ? starts[i + 1] : count[d]) - starts[i];
+    }
+}
+
+
+void DataStream::read(size_t index, std::vector<char> &buffer) {
+    NDSize block_offset, block_count;
+    blockAt(index, block_offset, block_count);
+    array.getData(dtype, buffer.data(), block_count, offset + block_offset);
+}
+
+
+void DataStream::run() {
+    for (size_t index = 0; index < nblocks; index++) {
+        size_t buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            drained.wait(lock, [&] { return stop || !free_buffers.empty(); });
+            if (stop) {
+                return;
+            }
+            buffer = free_buffers.back();
+            free_buffers.pop_back();
+        }
+
+        try {
+            read(index, pool[buffer]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            filled.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.emplace_back(index, buffer);
+        }
+        filled.notify_one();
+    }
+}
+
+
+bool DataStream::next() {
+    if (!reader.joinable()) {
+        if (position >= nblocks) {
+            return false;
+        }
+        read(position, pool[0]);
+        current_buffer = 0;
+
+    } else {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (current_buffer != NO_BUFFER) {
+            free_buffers.push_back(current_buffer);
+            current_buffer = NO_BUFFER;
+            drained.notify_one();
+        }
+
+        if (position >= nblocks) {
+            return false;
+        }
+
+        // blocks read before an error are still handed out
+        filled.wait(lock, [&] { return !ready.empty() || error; });
+        if (ready.empty()) {
+            position = nblocks;
+            std::rethrow_exception(error);
+        }
+
+        current_buffer = ready.front().second;
+        ready.pop_front();
+    }
+
+    blockAt(position++, current.offset, current.count);
+    current.buffer = pool[current_buffer].data();
+    return true;
+}
+
+
+DataStream::iterator DataStream::begin() {
+    return next() ? iterator(this) : iterator();
+}
+
+
+DataStream::~DataStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    drained.notify_all();
+
+    if (reader.joinable()) {
+        reader.join();
+    }
+}
+
+} // namespace nix
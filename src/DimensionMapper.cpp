@@ -0,0 +1,144 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DimensionMapper.hpp>
+
+#include <nix/util/util.hpp>
+
+#include <cmath>
+
+using namespace std;
+
+namespace nix {
+
+
+DimensionMapper::DimensionMapper(const Dimension &dimension, const string &unit)
+    : type(dimension.dimensionType()), scaling(1.0), offset(0.0), interval(1.0), label_count(0)
+{
+    if (type == DimensionType::Set) {
+        if (unit.length() > 0 && unit != "none") {
+            throw IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "DimensionMapper");
+        }
+        label_count = dimension.asSetDimension().labels().size();
+        return;
+    }
+
+    boost::optional<string> dim_unit;
+    if (type == DimensionType::Sample) {
+        SampledDimension dim = dimension.asSampledDimension();
+        dim_unit = dim.unit();
+        if (!dim_unit && unit != "none") {
+            throw IncompatibleDimensions("Units of position and SampledDimension must both be given!", "DimensionMapper");
+        }
+
+        boost::optional<double> dim_offset = dim.offset();
+        offset = dim_offset ? *dim_offset : 0.0;
+        interval = dim.samplingInterval();
+    } else {
+        range = dimension.asRangeDimension();
+        dim_unit = range.unit();
+    }
+
+    if (dim_unit && unit != "none") {
+        try {
+            scaling = util::getSIScaling(unit, *dim_unit);
+        } catch (...) {
+            throw IncompatibleDimensions("Provided units are not scalable!", "DimensionMapper");
+        }
+    }
+}
+
+
+size_t DimensionMapper::indexOf(double position) const {
+    size_t index;
+    indexOf(&position, 1, &index);
+    return index;
+}
+
+
+void DimensionMapper::indexOf(const double *positions, size_t count, size_t *indices) const {
+    if (type == DimensionType::Set) {
+        double highest = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            double index = round(positions[i]);
+            highest = index > highest ? index : highest;
+            indices[i] = static_cast<size_t>(index);
+        }
+
+        if (label_count > 0 && highest > static_cast<double>(label_count)) {
+            throw OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(highest));
+        }
+
+    } else if (type == DimensionType::Sample) {
+        // branch free, so that the compiler can vectorize it; the bounds
+        // are checked once afterwards
+        double lowest = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            double index = round((positions[i] * scaling - offset) / interval);
+            lowest = index < lowest ? index : lowest;
+            indices[i] = static_cast<size_t>(index > 0.0 ? index : 0.0);
+        }
+
+        if (lowest < 0.0) {
+            throw OutOfBounds("Position is out of bounds of this dimension!", 0);
+        }
+
+    } else {
+        vector<double> scaled(positions, positions + count);
+        if (scaling != 1.0) {
+            for (double &position : scaled) {
+                position *= scaling;
+            }
+        }
+
+        vector<size_t> found = range.indexOf(scaled);
+        copy(found.begin(), found.end(), indices);
+    }
+}
+
+
+vector<size_t> DimensionMapper::indexOf(const vector<double> &positions) const {
+    vector<size_t> indices(positions.size());
+    indexOf(positions.data(), positions.size(), indices.data());
+    return indices;
+}
+
+
+double DimensionMapper::positionAt(size_t index) const {
+    double position;
+    positionAt(&index, 1, &position);
+    return position;
+}
+
+
+void DimensionMapper::positionAt(const size_t *indices, size_t count, double *positions) const {
+    if (type == DimensionType::Set) {
+        for (size_t i = 0; i < count; i++) {
+            positions[i] = static_cast<double>(indices[i]);
+        }
+
+    } else if (type == DimensionType::Sample) {
+        for (size_t i = 0; i < count; i++) {
+            positions[i] = (indices[i] * interval + offset) / scaling;
+        }
+
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            positions[i] = range.tickAt(indices[i]) / scaling;
+        }
+    }
+}
+
+
+vector<double> DimensionMapper::positionAt(const vector<size_t> &indices) const {
+    vector<double> positions(indices.size());
+    positionAt(indices.data(), indices.size(), positions.data());
+    return positions;
+}
+
+} // namespace nix
@@ -337,32 +337,75 @@ void RangeDimension::ticks(const std::vector<double> &ticks) {
 
 
 double RangeDimension::tickAt(const size_t index) const {
-    vector<double> ticks = this->ticks();
-    if (index >= ticks.size()) {
+    shared_ptr<const vector<double>> ticks = backend()->sharedTicks();
+    if (index >= ticks->size()) {
         throw nix::OutOfBounds("RangeDimension::tickAt: Given index is out of bounds!", index);
     }
-    return ticks[index];
+    return (*ticks)[index];
 }
 
 
 size_t RangeDimension::indexOf(const double position) const {
-    vector<double> ticks = this->ticks();
-    if (position < *ticks.begin()) {
+    shared_ptr<const vector<double>> ticks = backend()->sharedTicks();
+    if (ticks->empty()) {
+        throw nix::OutOfBounds("RangeDimension::indexOf: Dimension has no ticks!");
+    }
+    if (position < ticks->front()) {
         return 0;
-    } else if (position > *prev(ticks.end())) {
-        return prev(ticks.end()) - ticks.begin();
+    } else if (position > ticks->back()) {
+        return ticks->size() - 1;
+    }
+    return std::lower_bound(ticks->begin(), ticks->end(), position) - ticks->begin();
+}
+
+
+vector<size_t> RangeDimension::indexOf(const vector<double> &positions) const {
+    shared_ptr<const vector<double>> ticks = backend()->sharedTicks();
+    if (ticks->empty() && !positions.empty()) {
+        throw nix::OutOfBounds("RangeDimension::indexOf: Dimension has no ticks!");
+    }
+
+    const size_t last = ticks->size() - 1;
+    vector<size_t> indices(positions.size());
+
+    // few queries: binary search each of them
+    if (positions.size() * 8 < ticks->size()) {
+        for (size_t i = 0; i < positions.size(); i++) {
+            size_t index = std::lower_bound(ticks->begin(), ticks->end(), positions[i]) - ticks->begin();
+            indices[i] = std::min(index, last);
+        }
+        return indices;
+    }
+
+    // otherwise sweep the ticks once, with the queries in ascending order
+    vector<size_t> order(positions.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    if (!std::is_sorted(positions.begin(), positions.end())) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return positions[a] < positions[b];
+        });
     }
-    vector<double>::iterator low = std::lower_bound (ticks.begin(), ticks.end(), position);
-    return low - ticks.begin();
+
+    size_t index = 0;
+    for (size_t i : order) {
+        while (index < last && (*ticks)[index] < positions[i]) {
+            index++;
+        }
+        indices[i] = index;
+    }
+
+    return indices;
 }
 
 
 vector<double> RangeDimension::axis(const size_t count, const size_t startIndex) const {
-    vector<double> ticks = this->ticks();
-    if ((startIndex + count) > ticks.size()) {
+    shared_ptr<const vector<double>> ticks = backend()->sharedTicks();
+    if ((startIndex + count) > ticks->size()) {
         throw nix::OutOfBounds("RangeDimension::axis: Count is invalid, reaches beyond the ticks stored in this dimension.");
     } 
-    vector<double>::const_iterator first = ticks.begin() + startIndex;
+    vector<double>::const_iterator first = ticks->begin() + startIndex;
     vector<double> axis(first, first + count);
     return axis;
 }
@@ -26,6 +26,15 @@ File File::open(const std::string &name, FileMode mode, const std::string &impl)
 }
 
 
+File File::open(const std::string &name, FileMode mode, const ChunkCache &cache, const std::string &impl) {
+    if (impl == "hdf5") {
+        return File(std::make_shared<hdf5::FileHDF5>(name, mode, cache));
+    } else {
+        throw runtime_error("Unknown implementation!");
+    }
+}
+
+
 Block File::createBlock(const std::string &name, const std::string &type) {
     util::checkEntityNameAndType(name, type);
     if (backend()->hasBlock(name)) {
@@ -49,9 +58,14 @@ bool File::deleteBlock(const Block &block) {
 
 std::vector<Block> File::blocks(const util::Filter<Block>::type &filter) const
 {
-    auto f = [this] (ndsize_t i) { return getBlock(i); };
-    return getEntities<Block>(f,
-                              blockCount(),
+    return getEntities<Block>(backend()->getBlocks(util::Match::of(filter)),
+                              filter);
+}
+
+EntityRange<Block> File::blockRange(const util::Filter<Block>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Block>(container->blockKeys(util::Match::of(filter).withoutType()),
+                              [container](const std::string &key) { return Block(container->getBlock(key)); },
                               filter);
 }
 
@@ -73,9 +87,14 @@ bool File::hasSection(const Section &section) const {
 
 std::vector<Section> File::sections(const util::Filter<Section>::type &filter) const
 {
-    auto f = [this] (ndsize_t i) { return getSection(i); };
-    return getEntities<Section>(f,
-                                sectionCount(),
+    return getEntities<Section>(backend()->getSections(util::Match::of(filter)),
+                                filter);
+}
+
+EntityRange<Section> File::sectionRange(const util::Filter<Section>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Section>(container->sectionKeys(util::Match::of(filter).withoutType()),
+                                [container](const std::string &key) { return Section(container->getSection(key)); },
                                 filter);
 }
 
@@ -88,6 +107,12 @@ bool File::deleteSection(const Section &section) {
 
 vector<Section> File::findSections(const util::Filter<Section>::type &filter, size_t max_depth) const {
 
+    // filters on id, name or type are answered by the section index
+    util::Match match = util::Match::of(filter);
+    if (match.field != util::Match::Field::All) {
+        return getEntities<Section>(backend()->findSections(match, max_depth), filter);
+    }
+
     vector<Section> results;
 
     vector<Section> roots = sections();
@@ -0,0 +1,309 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MetadataTree.hpp>
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+
+namespace nix {
+
+const size_t MetadataTree::npos;
+
+
+static boost::optional<string> optional_string(const string *str) {
+    boost::optional<string> ret;
+    if (str) {
+        ret = *str;
+    }
+    return ret;
+}
+
+// index of the node with the given name or id, or npos
+template<typename Node>
+static size_t find_node(const vector<Node> &nodes, const vector<size_t> &indices, const string &name_or_id) {
+    for (size_t i : indices) {
+        const Node &node = nodes[i];
+        if (*node.name == name_or_id || *node.id == name_or_id) {
+            return i;
+        }
+    }
+    return MetadataTree::npos;
+}
+
+
+const string *MetadataTree::Data::intern(const string &str) {
+    return &*strings.insert(str).first;
+}
+
+//--------------------------------------------------
+// MetadataTree::Property
+//--------------------------------------------------
+
+const MetadataTree::PropertyNode &MetadataTree::Property::node() const {
+    if (isNone()) {
+        throw runtime_error("MetadataTree::Property: empty property handle");
+    }
+    return data->properties[index];
+}
+
+
+const string &MetadataTree::Property::id() const {
+    return *node().id;
+}
+
+
+const string &MetadataTree::Property::name() const {
+    return *node().name;
+}
+
+
+boost::optional<string> MetadataTree::Property::definition() const {
+    return optional_string(node().definition);
+}
+
+
+boost::optional<string> MetadataTree::Property::unit() const {
+    return optional_string(node().unit);
+}
+
+
+boost::optional<string> MetadataTree::Property::mapping() const {
+    return optional_string(node().mapping);
+}
+
+
+time_t MetadataTree::Property::createdAt() const {
+    return node().created_at;
+}
+
+
+time_t MetadataTree::Property::updatedAt() const {
+    return node().updated_at;
+}
+
+
+DataType MetadataTree::Property::dataType() const {
+    return node().data_type;
+}
+
+
+ndsize_t MetadataTree::Property::valueCount() const {
+    return node().values.size();
+}
+
+
+const vector<Value> &MetadataTree::Property::values() const {
+    return node().values;
+}
+
+
+MetadataTree::Section MetadataTree::Property::section() const {
+    return Section(data, node().section);
+}
+
+//--------------------------------------------------
+// MetadataTree::Section
+//--------------------------------------------------
+
+const MetadataTree::SectionNode &MetadataTree::Section::node() const {
+    if (isNone()) {
+        throw runtime_error("MetadataTree::Section: empty section handle");
+    }
+    return data->sections[index];
+}
+
+
+const string &MetadataTree::Section::id() const {
+    return *node().id;
+}
+
+
+const string &MetadataTree::Section::name() const {
+    return *node().name;
+}
+
+
+const string &MetadataTree::Section::type() const {
+    return *node().type;
+}
+
+
+boost::optional<string> MetadataTree::Section::definition() const {
+    return optional_string(node().definition);
+}
+
+
+boost::optional<string> MetadataTree::Section::repository() const {
+    return optional_string(node().repository);
+}
+
+
+boost::optional<string> MetadataTree::Section::mapping() const {
+    return optional_string(node().mapping);
+}
+
+
+time_t MetadataTree::Section::createdAt() const {
+    return node().created_at;
+}
+
+
+time_t MetadataTree::Section::updatedAt() const {
+    return node().updated_at;
+}
+
+
+MetadataTree::Section MetadataTree::Section::link() const {
+    size_t link = node().link;
+    return link == npos ? Section() : Section(data, link);
+}
+
+
+MetadataTree::Section MetadataTree::Section::parent() const {
+    size_t parent = node().parent;
+    return parent == npos ? Section() : Section(data, parent);
+}
+
+
+ndsize_t MetadataTree::Section::sectionCount() const {
+    return node().sections.size();
+}
+
+
+bool MetadataTree::Section::hasSection(const string &name_or_id) const {
+    return find_node(data->sections, node().sections, name_or_id) != npos;
+}
+
+
+MetadataTree::Section MetadataTree::Section::getSection(const string &name_or_id) const {
+    size_t found = find_node(data->sections, node().sections, name_or_id);
+    return found == npos ? Section() : Section(data, found);
+}
+
+
+MetadataTree::Section MetadataTree::Section::getSection(ndsize_t index) const {
+    const vector<size_t> &children = node().sections;
+    if (index >= children.size()) {
+        throw OutOfBounds("Index is out of bounds when calling MetadataTree::Section::getSection(index)!");
+    }
+    return Section(data, children[index]);
+}
+
+
+vector<MetadataTree::Section> MetadataTree::Section::sections() const {
+    const vector<size_t> &children = node().sections;
+    vector<Section> result;
+    result.reserve(children.size());
+    for (size_t i : children) {
+        result.emplace_back(data, i);
+    }
+    return result;
+}
+
+
+ndsize_t MetadataTree::Section::propertyCount() const {
+    return node().properties.size();
+}
+
+
+bool MetadataTree::Section::hasProperty(const string &name_or_id) const {
+    return find_node(data->properties, node().properties, name_or_id) != npos;
+}
+
+
+MetadataTree::Property MetadataTree::Section::getProperty(const string &name_or_id) const {
+    size_t found = find_node(data->properties, node().properties, name_or_id);
+    return found == npos ? Property() : Property(data, found);
+}
+
+
+MetadataTree::Property MetadataTree::Section::getProperty(ndsize_t index) const {
+    const vector<size_t> &properties = node().properties;
+    if (index >= properties.size()) {
+        throw OutOfBounds("Index is out of bounds when calling MetadataTree::Section::getProperty(index)!");
+    }
+    return Property(data, properties[index]);
+}
+
+
+vector<MetadataTree::Property> MetadataTree::Section::properties() const {
+    const vector<size_t> &properties = node().properties;
+    vector<Property> result;
+    result.reserve(properties.size());
+    for (size_t i : properties) {
+        result.emplace_back(data, i);
+    }
+    return result;
+}
+
+//--------------------------------------------------
+// MetadataTree
+//--------------------------------------------------
+
+MetadataTree::MetadataTree()
+    : data(make_shared<Data>())
+{}
+
+
+MetadataTree::MetadataTree(const shared_ptr<const Data> &data)
+    : data(data)
+{}
+
+
+ndsize_t MetadataTree::sectionCount() const {
+    return data->roots.size();
+}
+
+
+bool MetadataTree::hasSection(const string &name_or_id) const {
+    return find_node(data->sections, data->roots, name_or_id) != npos;
+}
+
+
+MetadataTree::Section MetadataTree::getSection(const string &name_or_id) const {
+    size_t found = find_node(data->sections, data->roots, name_or_id);
+    return found == npos ? Section() : Section(data, found);
+}
+
+
+MetadataTree::Section MetadataTree::getSection(ndsize_t index) const {
+    if (index >= data->roots.size()) {
+        throw OutOfBounds("Index is out of bounds when calling MetadataTree::getSection(index)!");
+    }
+    return Section(data, data->roots[index]);
+}
+
+
+vector<MetadataTree::Section> MetadataTree::sections() const {
+    vector<Section> result;
+    result.reserve(data->roots.size());
+    for (size_t i : data->roots) {
+        result.emplace_back(data, i);
+    }
+    return result;
+}
+
+
+MetadataTree::Section MetadataTree::findSection(const string &id) const {
+    auto it = data->section_ids.find(id);
+    return it == data->section_ids.end() ? Section() : Section(data, it->second);
+}
+
+
+size_t MetadataTree::totalSectionCount() const {
+    return data->sections.size();
+}
+
+
+size_t MetadataTree::totalPropertyCount() const {
+    return data->properties.size();
+}
+
+} // namespace nix
@@ -85,9 +85,14 @@ bool MultiTag::removeReference(const DataArray &reference) {
 
 
 std::vector<DataArray> MultiTag::references(const util::Filter<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getReference(i); };
-    return getEntities<DataArray>(f,
-                                  referenceCount(),
+    return getEntities<DataArray>(backend()->getReferences(util::Match::of(filter)),
+                                  filter);
+}
+
+EntityRange<DataArray> MultiTag::referenceRange(const util::Filter<DataArray>::type &filter) const {
+    auto container = impl();
+    return EntityRange<DataArray>(container->referenceKeys(util::Match::of(filter).withoutType()),
+                                  [container](const std::string &key) { return DataArray(container->getReference(key)); },
                                   filter);
 }
 
@@ -97,6 +102,19 @@ DataView MultiTag::retrieveData(size_t position_index, size_t reference_index) c
 }
 
 
+void MultiTag::retrieveOffsets(size_t reference_index, std::vector<NDSize> &offsets, std::vector<NDSize> &counts) const {
+    if (reference_index >= referenceCount()) {
+        throw OutOfBounds("Reference index out of bounds.", 0);
+    }
+    util::getOffsetsAndCounts(*this, getReference(reference_index), offsets, counts);
+}
+
+
+DataSegments MultiTag::retrieveDataBatch(const std::vector<size_t> &position_indices, size_t reference_index) const {
+    return util::retrieveDataBatch(*this, position_indices, reference_index);
+}
+
+
 bool MultiTag::hasFeature(const Feature &feature) const {
     util::checkEntityInput(feature);
     return backend()->hasFeature(feature.id());
@@ -104,9 +122,7 @@ bool MultiTag::hasFeature(const Feature &feature) const {
 
 
 std::vector<Feature> MultiTag::features(const util::Filter<Feature>::type &filter) const {
-    auto f = [this] (size_t i) { return getFeature(i); };
-    return getEntities<Feature>(f,
-                                featureCount(),
+    return getEntities<Feature>(backend()->getFeatures(util::Match::of(filter)),
                                 filter);
 }
 
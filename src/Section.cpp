@@ -89,9 +89,14 @@ struct SectionCont {
 
 
 std::vector<Section> Section::sections(const util::Filter<Section>::type &filter) const {
-    auto f = [this] (ndsize_t i) { return getSection(i); };
-    return getEntities<Section>(f,
-                                sectionCount(),
+    return getEntities<Section>(backend()->getSections(util::Match::of(filter)),
+                                filter);
+}
+
+EntityRange<Section> Section::sectionRange(const util::Filter<Section>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Section>(container->sectionKeys(util::Match::of(filter).withoutType()),
+                                [container](const std::string &key) { return Section(container->getSection(key)); },
                                 filter);
 }
 
@@ -99,6 +104,12 @@ std::vector<Section> Section::sections(const util::Filter<Section>::type &filter
 std::vector<Section> Section::findSections(const util::Filter<Section>::type &filter,
                                            size_t max_depth) const
 {
+    // filters on id, name or type are answered by the section index
+    util::Match match = util::Match::of(filter);
+    if (match.field != util::Match::Field::All) {
+        return getEntities<Section>(backend()->findSections(match, max_depth), filter);
+    }
+
     std::vector<Section>  results;
     std::list<SectionCont> todo;
 
@@ -173,12 +184,17 @@ bool Section::hasProperty(const Property &property) const {
 }
 
 std::vector<Property> Section::properties(const util::Filter<Property>::type &filter) const {
-    auto f = [this] (ndsize_t i) { return getProperty(i); };
-    return getEntities<Property>(f,
-            propertyCount(),
+    return getEntities<Property>(backend()->getProperties(util::Match::of(filter)),
             filter);
 }
 
+EntityRange<Property> Section::propertyRange(const util::Filter<Property>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Property>(container->propertyKeys(util::Match::of(filter).withoutType()),
+                                 [container](const std::string &key) { return Property(container->getProperty(key)); },
+                                 filter);
+}
+
 bool Section::deleteProperty(const Property &property) {
     if (property == none) {
         throw std::runtime_error("Section::deleteProperty: Empty Property entity given!");
@@ -225,8 +241,20 @@ size_t Section::tree_depth() const{
 }
 
 
-vector<Section> Section::findDownstream(const std::function<bool(Section)> &filter) const{
+vector<Section> Section::findDownstream(const util::Filter<Section>::type &filter) const{
     vector<Section> results;
+
+    if (util::Match::of(filter).field != util::Match::Field::All) {
+        // indexed search: no need to determine the depth of the tree
+        if (findSections(filter).empty()) {
+            return results;
+        }
+        for (size_t depth = 1; results.empty(); depth++) {
+            results = findSections(filter, depth);
+        }
+        return results;
+    }
+
     size_t max_depth = tree_depth();
     size_t actual_depth = 1;
     while (results.size() == 0 && actual_depth <= max_depth) {
@@ -237,7 +265,7 @@ vector<Section> Section::findDownstream(const std::function<bool(Section)> &filt
 }
 
 
-vector<Section> Section::findUpstream(const std::function<bool(Section)> &filter) const{
+vector<Section> Section::findUpstream(const util::Filter<Section>::type &filter) const{
     vector<Section> results;
     Section p = parent();
 
@@ -252,7 +280,7 @@ vector<Section> Section::findUpstream(const std::function<bool(Section)> &filter
 }
 
 
-vector<Section> Section::findSideways(const std::function<bool(Section)> &filter, const string &caller_id) const{
+vector<Section> Section::findSideways(const util::Filter<Section>::type &filter, const string &caller_id) const{
     vector<Section> results;
     Section p = parent();
     if (p != nullptr) {
@@ -0,0 +1,276 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/SegmentReducer.hpp>
+
+#include <nix/util/dataAccess.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace nix {
+
+// batches read ahead per worker
+static const size_t QUEUE_DEPTH = 2;
+
+
+namespace {
+
+struct Batch {
+    std::vector<double>   data;
+    std::vector<NDSize>   counts;
+    std::vector<ndsize_t> starts;
+};
+
+// running element-wise moments of one worker (Welford)
+struct Moments {
+    size_t              n = 0;
+    std::vector<double> sum, mean, m2, min, max;
+
+    explicit Moments(size_t nelms)
+        : sum(nelms, 0.0), mean(nelms, 0.0), m2(nelms, 0.0),
+          min(nelms, std::numeric_limits<double>::infinity()),
+          max(nelms, -std::numeric_limits<double>::infinity())
+    {}
+
+    void add(const double *x) {
+        const size_t nelms = mean.size();
+        const double inv = 1.0 / static_cast<double>(++n);
+        double *s = sum.data(), *mu = mean.data(), *q = m2.data(), *lo = min.data(), *hi = max.data();
+
+        // plain loops over contiguous data, vectorized by the compiler
+        for (size_t i = 0; i < nelms; i++) {
+            const double delta = x[i] - mu[i];
+            mu[i] += delta * inv;
+            q[i] += delta * (x[i] - mu[i]);
+            s[i] += x[i];
+        }
+
+        for (size_t i = 0; i < nelms; i++) {
+            lo[i] = x[i] < lo[i] ? x[i] : lo[i];
+            hi[i] = x[i] > hi[i] ? x[i] : hi[i];
+        }
+    }
+
+    void merge(const Moments &other) {
+        if (other.n == 0) {
+            return;
+        }
+
+        const double na = static_cast<double>(n), nb = static_cast<double>(other.n);
+        const double total = na + nb;
+        for (size_t i = 0; i < mean.size(); i++) {
+            const double delta = other.mean[i] - mean[i];
+            mean[i] += delta * nb / total;
+            m2[i] += other.m2[i] + delta * delta * na * nb / total;
+            sum[i] += other.sum[i];
+            min[i] = std::min(min[i], other.min[i]);
+            max[i] = std::max(max[i], other.max[i]);
+        }
+        n += other.n;
+    }
+};
+
+} // anonymous namespace
+
+
+SegmentReducer::SegmentReducer(const MultiTag &tag, size_t reference_index, size_t workers, size_t batch_bytes)
+    : tag(tag), nworkers(workers), batch_bytes(std::max<size_t>(batch_bytes, sizeof(double)))
+{
+    if (reference_index >= this->tag.referenceCount()) {
+        throw OutOfBounds("Reference index out of bounds.", 0);
+    }
+
+    array = this->tag.getReference(reference_index);
+
+    if (nworkers == 0) {
+        nworkers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+}
+
+
+std::vector<size_t> SegmentReducer::allPositions() const {
+    std::vector<size_t> indices(tag.positions().dataExtent()[0]);
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = i;
+    }
+    return indices;
+}
+
+
+SegmentReducer::Stats SegmentReducer::stats() const {
+    return stats(allPositions());
+}
+
+
+SegmentReducer::Stats SegmentReducer::stats(const std::vector<size_t> &position_indices) const {
+    std::vector<NDSize> offsets, counts;
+    util::getOffsetsAndCounts(tag, array, offsets, counts);
+
+    Stats result;
+    if (position_indices.empty()) {
+        return result;
+    }
+
+    for (size_t index : position_indices) {
+        if (index >= counts.size()) {
+            throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+        }
+        if (counts[index] != counts[position_indices[0]]) {
+            throw IncompatibleDimensions("All slices must have the same shape", "SegmentReducer::stats");
+        }
+    }
+
+    result.shape = counts[position_indices[0]];
+    const size_t nelms = check::fits_in_size_t(result.shape.nelms(), "SegmentReducer::stats: slice exceeds memory");
+
+    std::vector<Moments> accs(nworkers, Moments(nelms));
+    stream(position_indices, offsets, counts, [&](size_t worker, const double *data, const NDSize &) {
+        accs[worker].add(data);
+    });
+
+    Moments &moments = accs[0];
+    for (size_t i = 1; i < accs.size(); i++) {
+        moments.merge(accs[i]);
+    }
+
+    result.count = moments.n;
+    result.sum = std::move(moments.sum);
+    result.mean = std::move(moments.mean);
+    result.min = std::move(moments.min);
+    result.max = std::move(moments.max);
+
+    result.variance = std::move(moments.m2);
+    const double dof = moments.n > 1 ? static_cast<double>(moments.n - 1) : 1.0;
+    for (double &v : result.variance) {
+        v /= dof;
+    }
+
+    return result;
+}
+
+
+void SegmentReducer::stream(const std::vector<size_t> &position_indices, const consumer_type &consume) const {
+    std::vector<NDSize> offsets, counts;
+    util::getOffsetsAndCounts(tag, array, offsets, counts);
+    stream(position_indices, offsets, counts, consume);
+}
+
+
+void SegmentReducer::stream(const std::vector<size_t> &position_indices, const std::vector<NDSize> &offsets,
+                            const std::vector<NDSize> &counts, const consumer_type &consume) const {
+    for (size_t index : position_indices) {
+        if (index >= offsets.size()) {
+            throw OutOfBounds("Index out of bounds of positions or extents!", 0);
+        }
+        if (!util::positionAndExtentInData(array, offsets[index], counts[index])) {
+            throw OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+        }
+    }
+
+    std::mutex              mutex;
+    std::condition_variable filled;
+    std::condition_variable drained;
+    std::deque<Batch>       queue;
+    bool                    done = false;
+    std::exception_ptr      error;
+
+    auto work = [&](size_t worker) {
+        while (true) {
+            Batch batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                filled.wait(lock, [&] { return !queue.empty() || done || error; });
+                if (error || queue.empty()) {
+                    return;
+                }
+                batch = std::move(queue.front());
+                queue.pop_front();
+            }
+            drained.notify_one();
+
+            try {
+                for (size_t i = 0; i < batch.counts.size(); i++) {
+                    consume(worker, batch.data.data() + batch.starts[i], batch.counts[i]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                filled.notify_all();
+                drained.notify_all();
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nworkers; i++) {
+        threads.emplace_back(work, i);
+    }
+
+    // the calling thread does all the I/O
+    try {
+        const size_t batch_elms = batch_bytes / sizeof(double);
+        size_t pos = 0;
+
+        while (pos < position_indices.size()) {
+            Batch batch;
+            std::vector<NDSize> batch_offsets;
+            batch.starts.push_back(0);
+
+            // at least one slice per batch, however large it is
+            while (pos < position_indices.size() &&
+                   (batch.counts.empty() || batch.starts.back() + counts[position_indices[pos]].nelms() <= batch_elms)) {
+                const size_t index = position_indices[pos++];
+                batch_offsets.push_back(offsets[index]);
+                batch.counts.push_back(counts[index]);
+                batch.starts.push_back(batch.starts.back() + counts[index].nelms());
+            }
+
+            batch.data.resize(check::fits_in_size_t(batch.starts.back(), "SegmentReducer: batch exceeds memory"));
+            array.getDataSegments(DataType::Double, batch.data.data(), batch_offsets, batch.counts);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            drained.wait(lock, [&] { return queue.size() < QUEUE_DEPTH * nworkers || error; });
+            if (error) {
+                break;
+            }
+            queue.push_back(std::move(batch));
+            lock.unlock();
+            filled.notify_one();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    filled.notify_all();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace nix
@@ -57,9 +57,14 @@ bool Source::hasSource(const Source &source) const {
 
 
 std::vector<Source> Source::sources(const util::Filter<Source>::type &filter) const {
-    auto f = [this] (ndsize_t i) { return getSource(i); };
-    return getEntities<Source>(f,
-                               sourceCount(),
+    return getEntities<Source>(backend()->getSources(util::Match::of(filter)),
+                               filter);
+}
+
+EntityRange<Source> Source::sourceRange(const util::Filter<Source>::type &filter) const {
+    auto container = impl();
+    return EntityRange<Source>(container->sourceKeys(util::Match::of(filter).withoutType()),
+                               [container](const std::string &key) { return Source(container->getSource(key)); },
                                filter);
 }
 
@@ -80,6 +85,12 @@ struct SourceCont {
 std::vector<Source> Source::findSources(const util::Filter<Source>::type &filter,
                                         size_t max_depth) const
 {
+    // filters on id, name or type are answered by the source index
+    util::Match match = util::Match::of(filter);
+    if (match.field != util::Match::Field::All) {
+        return getEntities<Source>(backend()->findSources(match, max_depth), filter);
+    }
+
     std::vector<Source>  results;
     std::queue<SourceCont> todo;
 
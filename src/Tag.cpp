@@ -64,9 +64,14 @@ bool Tag::removeReference(const DataArray &reference) {
 
 
 std::vector<DataArray> Tag::references(const util::Filter<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getReference(i); };
-    return getEntities<DataArray>(f,
-                                  referenceCount(),
+    return getEntities<DataArray>(backend()->getReferences(util::Match::of(filter)),
+                                  filter);
+}
+
+EntityRange<DataArray> Tag::referenceRange(const util::Filter<DataArray>::type &filter) const {
+    auto container = impl();
+    return EntityRange<DataArray>(container->referenceKeys(util::Match::of(filter).withoutType()),
+                                  [container](const std::string &key) { return DataArray(container->getReference(key)); },
                                   filter);
 }
 
@@ -78,9 +83,7 @@ bool Tag::hasFeature(const Feature &feature) const {
 
 
 std::vector<Feature> Tag::features(const util::Filter<Feature>::type &filter) const {
-    auto f = [this] (size_t i) { return getFeature(i); };
-    return getEntities<Feature>(f,
-                                featureCount(),
+    return getEntities<Feature>(backend()->getFeatures(util::Match::of(filter)),
                                 filter);
 }
 
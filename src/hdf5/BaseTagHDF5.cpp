@@ -14,6 +14,8 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/BlockHDF5.hpp>
 #include <nix/hdf5/FeatureHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
+#include <nix/base/IMultiTag.hpp>
 #include <nix/Exception.hpp>
 
 #include <algorithm>
@@ -48,6 +50,22 @@ BaseTagHDF5::BaseTagHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock>
     refs_group = this->group().openOptGroup("references");
 }
 
+
+ReferenceIndex &BaseTagHDF5::referenceIndex() const {
+    return fileHDF5()->referenceIndex(block()->name());
+}
+
+
+ReferenceIndex::Referrer BaseTagHDF5::referrer(ReferenceIndex::Role role, const string &feature_id) const {
+    ReferenceIndex::Referrer ref;
+    ref.role = role;
+    ref.multi_tag = dynamic_cast<const IMultiTag *>(this) != nullptr;
+    ref.tag_id = id();
+    ref.tag_name = name();
+    ref.feature_id = feature_id;
+    return ref;
+}
+
 //--------------------------------------------------
 // Methods concerning references.
 //--------------------------------------------------
@@ -93,6 +111,27 @@ shared_ptr<IDataArray>  BaseTagHDF5::getReference(size_t index) const {
     return getReference(id);
 }
 
+vector<shared_ptr<IDataArray>> BaseTagHDF5::getReferences(const util::Match &match) const {
+    vector<shared_ptr<IDataArray>> entities;
+    boost::optional<Group> g = refs_group();
+
+    if (g) {
+        auto blk = block();
+        for (const auto &group : g->groups(match, util::Match::Field::Id)) {
+            entities.push_back(make_shared<DataArrayHDF5>(file(), blk, group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> BaseTagHDF5::referenceKeys(const util::Match &match) const {
+    boost::optional<Group> g = refs_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Id) : vector<string>();
+}
+
+
 void BaseTagHDF5::addReference(const std::string &name_or_id) {
     boost::optional<Group> g = refs_group(true);
 
@@ -102,6 +141,7 @@ void BaseTagHDF5::addReference(const std::string &name_or_id) {
     auto target = dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
     g->createLink(target->group(), target->id());
+    referenceIndex().add(target->id(), referrer(ReferenceIndex::Role::Reference));
 }
 
 
@@ -113,6 +153,7 @@ bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
         shared_ptr<IDataArray> reference = getReference(name_or_id);
 
         g->removeGroup(reference->id());
+        referenceIndex().remove(reference->id(), referrer(ReferenceIndex::Role::Reference));
         removed = true;
     }
 
@@ -193,6 +234,21 @@ shared_ptr<IFeature>  BaseTagHDF5::getFeature(size_t index) const {
 }
 
 
+vector<shared_ptr<IFeature>> BaseTagHDF5::getFeatures(const util::Match &match) const {
+    vector<shared_ptr<IFeature>> entities;
+    boost::optional<Group> g = feature_group();
+
+    if (g) {
+        auto blk = block();
+        for (const auto &group : g->groups(match, util::Match::Field::Id)) {
+            entities.push_back(make_shared<FeatureHDF5>(file(), blk, group));
+        }
+    }
+
+    return entities;
+}
+
+
 shared_ptr<IFeature>  BaseTagHDF5::createFeature(const std::string &name_or_id, LinkType link_type) {
     if(!block()->hasDataArray(name_or_id)) {
         throw std::runtime_error("DataArray not found in Block!");
@@ -202,7 +258,9 @@ shared_ptr<IFeature>  BaseTagHDF5::createFeature(const std::string &name_or_id,
 
     Group group = g->openGroup(rep_id, true);
     DataArray data = block()->getDataArray(name_or_id);
-    return make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+    auto feature = make_shared<FeatureHDF5>(file(), block(), group, rep_id, data, link_type);
+    referenceIndex().set(referrer(ReferenceIndex::Role::Feature, rep_id), data.id());
+    return feature;
 }
 
 
@@ -214,6 +272,7 @@ bool BaseTagHDF5::deleteFeature(const string &name_or_id) {
         shared_ptr<IFeature> feature = getFeature(name_or_id);
 
         g->removeGroup(feature->id());
+        referenceIndex().removeFeature(feature->id());
         deleted = true;
     }
 
@@ -14,6 +14,7 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/TagHDF5.hpp>
 #include <nix/hdf5/MultiTagHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 
 #include <boost/range/irange.hpp>
 
@@ -77,18 +78,54 @@ shared_ptr<ISource> BlockHDF5::getSource(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<ISource>> BlockHDF5::getSources(const util::Match &match) const {
+    vector<shared_ptr<ISource>> entities;
+    boost::optional<Group> g = source_group();
+
+    if (g) {
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<SourceHDF5>(file(), group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> BlockHDF5::sourceKeys(const util::Match &match) const {
+    boost::optional<Group> g = source_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 ndsize_t BlockHDF5::sourceCount() const {
     boost::optional<Group> g = source_group();
     return g ? g->objectCount() : size_t(0);
 }
 
 
+vector<shared_ptr<ISource>> BlockHDF5::findSources(const util::Match &match, size_t max_depth) const {
+    vector<shared_ptr<ISource>> entities;
+    const TreeIndex *index = fileHDF5()->sourceIndex(name());
+
+    if (index) {
+        for (const TreeIndex::Entry *entry : index->find(match, nullptr, max_depth)) {
+            entities.push_back(make_shared<SourceHDF5>(file(), index->open(*entry)));
+        }
+    }
+
+    return entities;
+}
+
+
 shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &type) {
     string id = util::createId();
     boost::optional<Group> g = source_group(true);
 
     Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), group, id, type, name);
+    fileHDF5()->sourceIndex(this->name())->add("", id, name, type);
+    return source;
 }
 
 
@@ -107,6 +144,7 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            fileHDF5()->sourceIndex(name())->remove(source.id());
         }
     }
 
@@ -155,6 +193,27 @@ shared_ptr<ITag> BlockHDF5::getTag(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<ITag>> BlockHDF5::getTags(const util::Match &match) const {
+    vector<shared_ptr<ITag>> entities;
+    boost::optional<Group> g = tag_group();
+
+    if (g) {
+        auto blk = block();
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<TagHDF5>(file(), blk, group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> BlockHDF5::tagKeys(const util::Match &match) const {
+    boost::optional<Group> g = tag_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 ndsize_t BlockHDF5::tagCount() const {
     boost::optional<Group> g = tag_group();
     return g ? g->objectCount() : size_t(0);
@@ -167,7 +226,9 @@ bool BlockHDF5::deleteTag(const std::string &name_or_id) {
 
     if (hasTag(name_or_id) && g) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getTag(name_or_id)->name());
+        shared_ptr<ITag> tag = getTag(name_or_id);
+        deleted = g->removeAllLinks(tag->name());
+        fileHDF5()->referenceIndex(name()).removeTag(tag->id());
     }
 
     return deleted;
@@ -205,6 +266,27 @@ shared_ptr<IDataArray> BlockHDF5::getDataArray(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<IDataArray>> BlockHDF5::getDataArrays(const util::Match &match) const {
+    vector<shared_ptr<IDataArray>> entities;
+    boost::optional<Group> g = data_array_group();
+
+    if (g) {
+        auto blk = block();
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<DataArrayHDF5>(file(), blk, group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> BlockHDF5::dataArrayKeys(const util::Match &match) const {
+    boost::optional<Group> g = data_array_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 ndsize_t BlockHDF5::dataArrayCount() const {
     boost::optional<Group> g = data_array_group();
     return g ? g->objectCount() : size_t(0);
@@ -214,7 +296,9 @@ ndsize_t BlockHDF5::dataArrayCount() const {
 shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
-                                                  const NDSize &shape) {
+                                                  const NDSize &shape,
+                                                  const Compression &compression,
+                                                  const NDSize &chunks) {
     string id = util::createId();
     boost::optional<Group> g = data_array_group(true);
 
@@ -222,7 +306,7 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape);
+    da->createData(data_type, shape, compression, chunks);
     return da;
 }
 
@@ -281,6 +365,27 @@ shared_ptr<IMultiTag> BlockHDF5::getMultiTag(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<IMultiTag>> BlockHDF5::getMultiTags(const util::Match &match) const {
+    vector<shared_ptr<IMultiTag>> entities;
+    boost::optional<Group> g = multi_tag_group();
+
+    if (g) {
+        auto blk = block();
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<MultiTagHDF5>(file(), blk, group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> BlockHDF5::multiTagKeys(const util::Match &match) const {
+    boost::optional<Group> g = multi_tag_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 ndsize_t BlockHDF5::multiTagCount() const {
     boost::optional<Group> g = multi_tag_group();
     return g ? g->objectCount() : size_t(0);
@@ -293,7 +398,9 @@ bool BlockHDF5::deleteMultiTag(const std::string &name_or_id) {
 
     if (hasMultiTag(name_or_id) && g) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getMultiTag(name_or_id)->name());
+        shared_ptr<IMultiTag> mtag = getMultiTag(name_or_id);
+        deleted = g->removeAllLinks(mtag->name());
+        fileHDF5()->referenceIndex(name()).removeTag(mtag->id());
     }
 
     return deleted;
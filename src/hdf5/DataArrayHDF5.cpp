@@ -11,6 +11,15 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/DimensionHDF5.hpp>
+#include <nix/hdf5/TagHDF5.hpp>
+#include <nix/hdf5/MultiTagHDF5.hpp>
+#include <nix/hdf5/FeatureHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <unordered_set>
 
 using namespace std;
 using namespace nix::base;
@@ -18,6 +27,10 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+// upper bound of the hyperslabs combined into one selection; HDF5 merges
+// irregular hyperslabs in quadratic time, so larger unions do not pay off
+static const size_t SEGMENTS_PER_READ = 64;
+
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const Group &group)
         : EntityWithSourcesHDF5(file, block, group) {
@@ -44,7 +57,7 @@ DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBl
 boost::optional<std::string> DataArrayHDF5::label() const {
     boost::optional<std::string> ret;
     string value;
-    bool have_attr = group().getAttr("label", value);
+    bool have_attr = getCachedAttr("label", value);
 
     if (have_attr) {
         ret = value;
@@ -55,15 +68,13 @@ boost::optional<std::string> DataArrayHDF5::label() const {
 
 
 void DataArrayHDF5::label(const string &label) {
-    group().setAttr("label", label);
+    setCachedAttr("label", label);
     forceUpdatedAt();
 }
 
 
 void DataArrayHDF5::label(const none_t t) {
-    if (group().hasAttr("label")) {
-        group().removeAttr("label");
-    }
+    removeCachedAttr("label");
     forceUpdatedAt();
 }
 
@@ -71,7 +82,7 @@ void DataArrayHDF5::label(const none_t t) {
 boost::optional<std::string> DataArrayHDF5::unit() const {
     boost::optional<std::string> ret;
     string value;
-    bool have_attr = group().getAttr("unit", value);
+    bool have_attr = getCachedAttr("unit", value);
     if (have_attr) {
         ret = value;
     }
@@ -80,15 +91,13 @@ boost::optional<std::string> DataArrayHDF5::unit() const {
 
 
 void DataArrayHDF5::unit(const string &unit) {
-    group().setAttr("unit", unit);
+    setCachedAttr("unit", unit);
     forceUpdatedAt();
 }
 
 
 void DataArrayHDF5::unit(const none_t t) {
-    if (group().hasAttr("unit")) {
-        group().removeAttr("unit");
-    }
+    removeCachedAttr("unit");
     forceUpdatedAt();
 }
 
@@ -97,7 +106,7 @@ void DataArrayHDF5::unit(const none_t t) {
 boost::optional<double> DataArrayHDF5::expansionOrigin() const {
     boost::optional<double> ret;
     double expansion_origin;
-    bool have_attr = group().getAttr("expansion_origin", expansion_origin);
+    bool have_attr = getCachedAttr("expansion_origin", expansion_origin);
     if (have_attr) {
         ret = expansion_origin;
     }
@@ -106,15 +115,13 @@ boost::optional<double> DataArrayHDF5::expansionOrigin() const {
 
 
 void DataArrayHDF5::expansionOrigin(double expansion_origin) {
-    group().setAttr("expansion_origin", expansion_origin);
+    setCachedAttr("expansion_origin", expansion_origin);
     forceUpdatedAt();
 }
 
 
 void DataArrayHDF5::expansionOrigin(const none_t t) {
-    if (group().hasAttr("expansion_origin")) {
-        group().removeAttr("expansion_origin");
-    }
+    removeCachedAttr("expansion_origin");
     forceUpdatedAt();
 }
 
@@ -219,6 +226,7 @@ Group DataArrayHDF5::createDimensionGroup(size_t index) {
     if (g->hasGroup(str_id)) {
         g->removeGroup(str_id);
     }
+    RangeDimensionHDF5::invalidateTicks();
 
     return g->openGroup(str_id, true);
 }
@@ -233,6 +241,7 @@ bool DataArrayHDF5::deleteDimension(size_t index) {
     if (g) {
         if (g->hasGroup(str_id)) {
             g->removeGroup(str_id);
+            RangeDimensionHDF5::invalidateTicks();
             deleted = true;
         }
 
@@ -257,86 +266,330 @@ DataArrayHDF5::~DataArrayHDF5() {
 }
 
 
-void DataArrayHDF5::createData(DataType dtype, const NDSize &size) {
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                               const NDSize &chunks) {
     if (group().hasData("data")) {
         throw new std::runtime_error("DataArray alread exists"); //TODO: FIXME, better exception
     }
 
-    group().createData("data", dtype, size); //FIXME: check if this 2-step creation is needed
-    DataSet ds = group().openData("data");
+    DataSet ds = group().createData("data", dtype, size, compression, chunks);
+    cacheDataSet(chunk_cache ? group().openData("data", *chunk_cache) : ds);
+    RangeDimensionHDF5::invalidateTicks();
 }
 
 bool DataArrayHDF5::hasData() const {
-    return group().hasData("data");
+    return data_set.isValid() || group().hasData("data");
 }
 
 void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
-    DataSet ds;
-
-    if (!group().hasData("data")) {
+    if (!openDataSet()) {
         //FIXME: this case should actually never be possible, replace with exception?
-        ds = group().createData("data", dtype, count);
-    } else {
-        ds = group().openData("data");
+        DataSet ds = group().createData("data", dtype, count);
+        cacheDataSet(chunk_cache ? group().openData("data", *chunk_cache) : ds);
     }
 
+    // the data may be the ticks of an aliased range dimension
+    RangeDimensionHDF5::invalidateTicks();
+
     if (offset.size()) {
-        Selection fileSel = ds.createSelection();
-        fileSel.select(count, offset);
-        Selection memSel(DataSpace::create(count, false));
+        Selection fileSel = fileSelection(count, offset);
+        Selection memSel = memSelection(count);
 
-        ds.write(dtype, data, fileSel, memSel);
+        data_set.write(dtype, data, fileSel, memSel);
     } else {
-        ds.write(dtype, count, data);
+        data_set.write(dtype, count, data);
     }
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    if (!group().hasData("data")) {
+    if (!openDataSet()) {
         return;
     }
 
-    DataSet ds = group().openData("data");
-
     if (offset.size()) {
-        Selection fileSel = ds.createSelection();
         // if count.size() == 0, i.e. we want to read a scalar,
         // we have to supply something that fileSel can make sense of
-        fileSel.select(count ? count : NDSize(offset.size(), 1), offset);
-        Selection memSel(DataSpace::create(count, false));
+        Selection fileSel = fileSelection(count ? count : NDSize(offset.size(), 1), offset);
+        Selection memSel = memSelection(count);
 
-        ds.read(dtype, data, fileSel, memSel);
+        data_set.read(dtype, data, fileSel, memSel);
     } else {
-        ds.read(dtype, count, data);
+        data_set.read(dtype, count, data);
     }
 
 }
 
+void DataArrayHDF5::readSegments(DataType dtype, void *data,
+                                 const vector<NDSize> &offsets, const vector<NDSize> &counts) const {
+    if (offsets.size() != counts.size()) {
+        throw IncompatibleDimensions("Number of offsets and counts do not match", "DataArrayHDF5::readSegments");
+    }
+
+    if (!openDataSet()) {
+        return;
+    }
+
+    // the data may have been resized through another handle
+    DataSpace file_space = data_set.getSpace();
+    const NDSize extent = file_space.extent();
+    const size_t rank = extent.size();
+    const size_t nsegs = offsets.size();
+
+    // start of every segment in the output buffer
+    vector<ndsize_t> starts(nsegs + 1, 0);
+    for (size_t i = 0; i < nsegs; i++) {
+        if (offsets[i].size() != rank || counts[i].size() != rank) {
+            throw IncompatibleDimensions("Offset and count must match the rank of the data", "DataArrayHDF5::readSegments");
+        }
+        starts[i + 1] = starts[i] + counts[i].nelms();
+    }
+
+    if (dtype == DataType::String || rank == 0) {
+        const size_t esize = dtype == DataType::String ? sizeof(string) : data_type_to_size(dtype);
+        char *out = static_cast<char *>(data);
+        for (size_t i = 0; i < nsegs; i++) {
+            read(dtype, out + starts[i] * esize, counts[i], offsets[i]);
+        }
+        return;
+    }
+
+    NDSize strides(rank, 1);
+    for (size_t d = rank - 1; d > 0; d--) {
+        strides[d - 1] = strides[d] * extent[d];
+    }
+
+    // first and last element of every segment in file order
+    struct Span {
+        ndsize_t first;
+        ndsize_t last;
+        size_t   index;
+    };
+
+    vector<Span> spans;
+    spans.reserve(nsegs);
+    for (size_t i = 0; i < nsegs; i++) {
+        if (starts[i + 1] == starts[i]) {
+            continue;
+        }
+        NDSize last = offsets[i] + counts[i];
+        last -= 1;
+        spans.push_back(Span{offsets[i].dot(strides), last.dot(strides), i});
+    }
+
+    sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+        return a.first < b.first || (a.first == b.first && a.last < b.last);
+    });
+
+    // HDF5 visits the elements of a union of hyperslabs in file order and
+    // merges overlapping hyperslabs, so only segments whose spans are
+    // disjoint can be read together. Spread them over as few passes as
+    // possible; a pass is read in chunk-sorted batches.
+    typedef pair<ndsize_t, size_t> pass_end;
+    priority_queue<pass_end, vector<pass_end>, greater<pass_end>> ends;
+    vector<vector<size_t>> passes;
+
+    for (const Span &span : spans) {
+        size_t pass;
+        if (!ends.empty() && ends.top().first < span.first) {
+            pass = ends.top().second;
+            ends.pop();
+        } else {
+            pass = passes.size();
+            passes.emplace_back();
+        }
+        passes[pass].push_back(span.index);
+        ends.push(pass_end(span.last, pass));
+    }
+
+    const size_t esize = data_type_to_size(dtype);
+    char *out = static_cast<char *>(data);
+    vector<char> scratch;
+
+    for (const vector<size_t> &pass : passes) {
+        for (size_t begin = 0; begin < pass.size(); begin += SEGMENTS_PER_READ) {
+            const size_t end = min(pass.size(), begin + SEGMENTS_PER_READ);
+
+            Selection fileSel(file_space);
+            bool contiguous = true;
+            ndsize_t total = 0;
+            for (size_t k = begin; k < end; k++) {
+                const size_t i = pass[k];
+                fileSel.select(counts[i], offsets[i], k == begin ? Selection::Mode::Set : Selection::Mode::Or);
+                contiguous = contiguous && (k == begin || starts[i] == starts[pass[k - 1] + 1]);
+                total += starts[i + 1] - starts[i];
+            }
+
+            if (contiguous) {
+                // the segments follow each other in the output as well
+                Selection memSel(DataSpace::create(NDSize{total}, false));
+                data_set.read(dtype, out + starts[pass[begin]] * esize, fileSel, memSel);
+            } else {
+                size_t nbytes = nix::check::fits_in_size_t(total * esize, "Segments exceed memory");
+                scratch.resize(nbytes);
+                Selection memSel(DataSpace::create(NDSize{total}, false));
+                data_set.read(dtype, scratch.data(), fileSel, memSel);
+
+                const char *pos = scratch.data();
+                for (size_t k = begin; k < end; k++) {
+                    const size_t i = pass[k];
+                    const size_t seg_bytes = (starts[i + 1] - starts[i]) * esize;
+                    memcpy(out + starts[i] * esize, pos, seg_bytes);
+                    pos += seg_bytes;
+                }
+            }
+        }
+    }
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
-    if (!group().hasData("data")) {
+    if (!openDataSet()) {
         return NDSize{};
     }
 
-    DataSet ds = group().openData("data");
-    return ds.size();
+    return data_set.getSpace().extent();
 }
 
 void DataArrayHDF5::dataExtent(const NDSize &extent) {
-    if (!group().hasData("data")) {
+    if (!openDataSet()) {
         throw runtime_error("Data field not found in DataArray!");
     }
 
-    DataSet ds = group().openData("data");
-    ds.setExtent(extent);
+    data_set.setExtent(extent);
+    RangeDimensionHDF5::invalidateTicks();
 }
 
 DataType DataArrayHDF5::dataType(void) const {
-    if (!group().hasData("data")) {
+    if (!openDataSet()) {
         return DataType::Nothing;
     }
 
-    DataSet ds = group().openData("data");
-    return ds.dataType();
+    return data_type;
+}
+
+NDSize DataArrayHDF5::dataChunks(void) const {
+    if (!openDataSet()) {
+        return NDSize{};
+    }
+
+    return data_set.chunking();
+}
+
+void DataArrayHDF5::chunkCache(const ChunkCache &cache) {
+    chunk_cache = cache;
+
+    // reopen the DataSet so that the new settings take effect
+    if (data_set.isValid()) {
+        data_set = DataSet();
+        openDataSet();
+    }
+}
+
+Compression DataArrayHDF5::compression(void) const {
+    if (!openDataSet()) {
+        return Compression();
+    }
+
+    return data_set.compression();
+}
+
+ChunkCache DataArrayHDF5::chunkCache(void) const {
+    if (!openDataSet()) {
+        return chunk_cache ? *chunk_cache : ChunkCache();
+    }
+
+    return data_set.chunkCache();
+}
+
+
+// the first link of each tag or multi-tag to an array, in index order
+static vector<const ReferenceIndex::Referrer *> tag_referrers(const vector<ReferenceIndex::Referrer> &referrers,
+                                                              bool multi_tag) {
+    vector<const ReferenceIndex::Referrer *> tags;
+    unordered_set<string> seen;
+    for (const ReferenceIndex::Referrer &referrer : referrers) {
+        if (referrer.multi_tag == multi_tag && seen.insert(referrer.tag_id).second) {
+            tags.push_back(&referrer);
+        }
+    }
+    return tags;
+}
+
+
+vector<shared_ptr<ITag>> DataArrayHDF5::referringTags() const {
+    vector<shared_ptr<ITag>> entities;
+    auto blk = block();
+    const ReferenceIndex &index = fileHDF5()->referenceIndex(blk->name());
+
+    for (const ReferenceIndex::Referrer *referrer : tag_referrers(index.find(id()), false)) {
+        entities.push_back(make_shared<TagHDF5>(file(), blk, index.openTag(*referrer)));
+    }
+
+    return entities;
+}
+
+
+vector<shared_ptr<IMultiTag>> DataArrayHDF5::referringMultiTags() const {
+    vector<shared_ptr<IMultiTag>> entities;
+    auto blk = block();
+    const ReferenceIndex &index = fileHDF5()->referenceIndex(blk->name());
+
+    for (const ReferenceIndex::Referrer *referrer : tag_referrers(index.find(id()), true)) {
+        entities.push_back(make_shared<MultiTagHDF5>(file(), blk, index.openTag(*referrer)));
+    }
+
+    return entities;
+}
+
+
+vector<shared_ptr<IFeature>> DataArrayHDF5::referringFeatures() const {
+    vector<shared_ptr<IFeature>> entities;
+    auto blk = block();
+    const ReferenceIndex &index = fileHDF5()->referenceIndex(blk->name());
+
+    for (const ReferenceIndex::Referrer &referrer : index.find(id())) {
+        if (referrer.role == ReferenceIndex::Role::Feature) {
+            entities.push_back(make_shared<FeatureHDF5>(file(), blk, index.openFeature(referrer)));
+        }
+    }
+
+    return entities;
+}
+
+
+bool DataArrayHDF5::openDataSet() const {
+    if (data_set.isValid()) {
+        return true;
+    }
+
+    if (!group().hasData("data")) {
+        return false;
+    }
+
+    cacheDataSet(chunk_cache ? group().openData("data", *chunk_cache) : group().openData("data"));
+    return true;
+}
+
+
+void DataArrayHDF5::cacheDataSet(const DataSet &ds) const {
+    data_set = ds;
+    data_type = ds.dataType();
+}
+
+
+Selection DataArrayHDF5::fileSelection(const NDSize &count, const NDSize &offset) const {
+    Selection sel(data_set.getSpace());
+    sel.select(count, offset);
+    return sel;
+}
+
+
+Selection DataArrayHDF5::memSelection(const NDSize &count) const {
+    if (!mem_space.isValid() || mem_count != count) {
+        mem_space = DataSpace::create(count, false);
+        mem_count = count;
+    }
+
+    return Selection(mem_space);
 }
 
 } // ns nix::hdf5
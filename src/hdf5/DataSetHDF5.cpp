@@ -9,6 +9,7 @@
 #include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/ExceptionHDF5.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -54,13 +55,13 @@ void DataSet::write(hid_t memType, const void *data)
 
 void DataSet::read(DataType dtype, const NDSize &size, void *data) const
 {
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = cached_h5_memtype(dtype);
 
     if (dtype == DataType::String) {
         StringWriter writer(size, static_cast<std::string *>(data));
         read(memType.h5id(), *writer);
         writer.finish();
-        vlenReclaim(memType.h5id(), *writer);
+        vlenReclaim(memType, *writer);
     } else {
         read(memType.h5id(), data);
     }
@@ -69,7 +70,7 @@ void DataSet::read(DataType dtype, const NDSize &size, void *data) const
 
 void DataSet::write(DataType dtype, const NDSize &size, const void *data)
 {
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = cached_h5_memtype(dtype);
     if (dtype == DataType::String) {
         StringReader reader(size, static_cast<const std::string *>(data));
         write(memType.h5id(), *reader);
@@ -84,7 +85,7 @@ void DataSet::read(DataType        dtype,
                    const Selection &fileSel,
                    const Selection &memSel) const
 {
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = cached_h5_memtype(dtype);
 
     HErr res;
     if (dtype == DataType::String) {
@@ -92,7 +93,8 @@ void DataSet::read(DataType        dtype,
         StringWriter writer(size, static_cast<std::string *>(data));
         res = H5Dread(hid, memType.h5id(), memSel.h5space().h5id(), fileSel.h5space().h5id(), H5P_DEFAULT, *writer);
         writer.finish();
-        vlenReclaim(memType.h5id(), *writer);
+        DataSpace memSpace = memSel.h5space();
+        vlenReclaim(memType, *writer, memSpace.isValid() ? &memSpace : nullptr);
     } else {
         res = H5Dread(hid, memType.h5id(), memSel.h5space().h5id(), fileSel.h5space().h5id(), H5P_DEFAULT, data);
     }
@@ -105,7 +107,7 @@ void DataSet::write(DataType         dtype,
                     const Selection &fileSel,
                     const Selection &memSel)
 {
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = cached_h5_memtype(dtype);
     HErr res;
 
     if (dtype == DataType::String) {
@@ -281,6 +283,66 @@ DataSpace DataSet::getSpace() const {
     return space;
 }
 
+
+NDSize DataSet::chunking() const {
+    BaseHDF5 dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not obtain creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    int rank = H5Pget_chunk(dcpl.h5id(), 0, nullptr);
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunking(): Could not obtain chunk rank");
+    }
+
+    NDSize chunks(static_cast<size_t>(rank));
+    HErr res = H5Pget_chunk(dcpl.h5id(), rank, chunks.data());
+    res.check("DataSet::chunking(): Could not obtain chunk shape");
+
+    return chunks;
+}
+
+
+Compression DataSet::compression() const {
+    BaseHDF5 dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::compression(): Could not obtain creation plist");
+
+    Compression compression;
+    int nfilters = H5Pget_nfilters(dcpl.h5id());
+
+    for (int i = 0; i < nfilters; i++) {
+        unsigned int flags;
+        size_t nelms = 1;
+        unsigned int values[1] = {0};
+
+        H5Z_filter_t filter = H5Pget_filter2(dcpl.h5id(), static_cast<unsigned>(i), &flags, &nelms, values,
+                                             0, nullptr, nullptr);
+        if (filter == H5Z_FILTER_DEFLATE) {
+            compression.deflate = static_cast<int>(values[0]);
+        } else if (filter == H5Z_FILTER_SHUFFLE) {
+            compression.shuffle = true;
+        } else if (filter == H5Z_FILTER_FLETCHER32) {
+            compression.fletcher32 = true;
+        }
+    }
+
+    return compression;
+}
+
+
+ChunkCache DataSet::chunkCache() const {
+    BaseHDF5 dapl = H5Dget_access_plist(hid);
+    dapl.check("DataSet::chunkCache(): Could not obtain access plist");
+
+    ChunkCache cache;
+    HErr res = H5Pget_chunk_cache(dapl.h5id(), &cache.slots, &cache.bytes, &cache.preemption);
+    res.check("DataSet::chunkCache(): Could not obtain chunk cache settings");
+
+    return cache;
+}
+
 /* Value related functions */
 
 template<typename T>
@@ -411,20 +473,57 @@ static h5x::DataType h5_type_for_value_dtype(DataType dtype, bool for_memory)
     }
 }
 
-h5x::DataType DataSet::fileTypeForValue(DataType dtype)
+// The compound types are built once per DataType and shared by all value
+// data sets; they must not be modified.
+struct ValueTypeTable {
+
+    static const size_t size = static_cast<size_t>(DataType::Opaque) + 1;
+
+    h5x::DataType file_types[size];
+    h5x::DataType mem_types[size];
+
+    ValueTypeTable() {
+        for (DataType dtype : {DataType::Bool, DataType::Int32, DataType::UInt32, DataType::Int64,
+                               DataType::UInt64, DataType::Double, DataType::String}) {
+            size_t index = static_cast<size_t>(dtype);
+            file_types[index] = h5_type_for_value_dtype(dtype, false);
+            mem_types[index] = h5_type_for_value_dtype(dtype, true);
+        }
+    }
+};
+
+
+static const h5x::DataType &cached_type_for_value(DataType dtype, bool for_memory)
 {
-    return h5_type_for_value_dtype(dtype, false);
+    static const ValueTypeTable table;
+
+    size_t index = static_cast<size_t>(dtype);
+    if (dtype == DataType::Nothing || index >= ValueTypeTable::size || !table.mem_types[index].isValid()) {
+        assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
+        static const h5x::DataType invalid;
+        return invalid;
+    }
+
+    return for_memory ? table.mem_types[index] : table.file_types[index];
+}
+
+const h5x::DataType &DataSet::fileTypeForValue(DataType dtype)
+{
+    return cached_type_for_value(dtype, false);
 }
 
-h5x::DataType DataSet::memTypeForValue(DataType dtype)
+const h5x::DataType &DataSet::memTypeForValue(DataType dtype)
 {
-    return h5_type_for_value_dtype(dtype, true);
+    return cached_type_for_value(dtype, true);
 }
 
+// the default size of the HDF5 conversion buffers
+static const size_t VALUE_XFER_BUFFER = 1024 * 1024;
+
 template<typename T>
 void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
 {
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = DataSet::memTypeForValue(to_data_type<T>::value);
 
     typedef FileValue<T> file_value_t;
     std::vector<file_value_t> fileValues;
@@ -432,7 +531,20 @@ void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
     fileValues.resize(size);
     values.resize(size);
 
-    h5ds.read(memType.h5id(), fileValues.data());
+    // By default HDF5 allocates type conversion buffers of 1 MiB for every
+    // read; with many values kept in memory these allocations end up
+    // growing the heap each time, so the buffers are sized to the values.
+    // Variable length strings take up to twice their reported size on disk.
+    const h5x::DataType &fileType = DataSet::fileTypeForValue(to_data_type<T>::value);
+    size_t bufferSize = std::min(size * 2 * std::max(fileType.size(), memType.size()), VALUE_XFER_BUFFER);
+
+    BaseHDF5 dxpl = H5Pcreate(H5P_DATASET_XFER);
+    dxpl.check("DataSet::read(): Could not create transfer plist");
+    HErr res = H5Pset_buffer(dxpl.h5id(), bufferSize, nullptr, nullptr);
+    res.check("DataSet::read(): Could not set conversion buffer size");
+
+    res = H5Dread(h5ds.h5id(), memType.h5id(), H5S_ALL, H5S_ALL, dxpl.h5id(), fileValues.data());
+    res.check("DataSet::read() IO error");
 
     std::transform(fileValues.begin(), fileValues.end(), values.begin(), [](const file_value_t &val) {
             Value temp(val.val());
@@ -495,7 +607,7 @@ void do_write_value(DataSet &h5ds, const std::vector<Value> &values)
             return fileVal;
         });
 
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = DataSet::memTypeForValue(to_data_type<T>::value);
     h5ds.write(memType.h5id(), fileValues.data());
 }
 
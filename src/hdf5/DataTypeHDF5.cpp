@@ -115,6 +115,35 @@ h5x::DataType data_type_to_h5_memtype(DataType dtype) {
     throw std::invalid_argument("DataType not handled!"); //FIXME
 }
 
+
+struct MemTypeTable {
+
+    static const size_t size = static_cast<size_t>(DataType::Opaque) + 1;
+
+    h5x::DataType types[size];
+
+    MemTypeTable() {
+        for (size_t i = 0; i < size; i++) {
+            DataType dtype = static_cast<DataType>(i);
+            if (dtype != DataType::Char) {
+                types[i] = data_type_to_h5_memtype(dtype);
+            }
+        }
+    }
+};
+
+
+const h5x::DataType &cached_h5_memtype(DataType dtype) {
+    static const MemTypeTable table;
+
+    size_t index = static_cast<size_t>(dtype);
+    if (dtype == DataType::Nothing || dtype == DataType::Char || index >= MemTypeTable::size) {
+        throw std::invalid_argument("DataType not handled!");
+    }
+
+    return table.types[index];
+}
+
 #define NOT_IMPLEMENTED false
 
 DataType
@@ -9,6 +9,8 @@
 #include <nix/hdf5/DimensionHDF5.hpp>
 #include <nix/util/util.hpp>
 
+#include <atomic>
+
 using namespace std;
 using namespace nix::base;
 
@@ -363,23 +365,45 @@ bool RangeDimensionHDF5::alias() const {
 }
 
 
-vector<double> RangeDimensionHDF5::ticks() const {
-    vector<double> ticks;
+// bumped whenever ticks or data that may serve as ticks are written
+static std::atomic<size_t> tick_generations(1);
+
+
+void RangeDimensionHDF5::invalidateTicks() {
+    tick_generations++;
+}
+
+
+shared_ptr<const vector<double>> RangeDimensionHDF5::sharedTicks() const {
+    const size_t generation = tick_generations.load();
+    if (tick_cache && tick_generation == generation) {
+        return tick_cache;
+    }
+
+    auto ticks = make_shared<vector<double>>();
     Group g = redirectGroup();
     if (g.hasData("ticks")) {
-        g.getData("ticks", ticks);
-        return ticks;
+        g.getData("ticks", *ticks);
     } else if (g.hasData("data")) {
-        g.getData("data", ticks);
-        return ticks;
+        g.getData("data", *ticks);
     } else {
         throw MissingAttr("ticks");
     }
+
+    tick_cache = ticks;
+    tick_generation = generation;
+    return tick_cache;
+}
+
+
+vector<double> RangeDimensionHDF5::ticks() const {
+    return *sharedTicks();
 }
 
 
 void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     Group g = redirectGroup();
+    invalidateTicks();
     if (!alias()) {
         g.setData("ticks", ticks);
     } else if (g.hasData("data")) {
@@ -7,10 +7,12 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/hdf5/EntityHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 
 #include <nix/util/util.hpp>
 
 #include <ctime>
+#include <exception>
 
 using namespace std;
 using namespace nix::base;
@@ -19,8 +21,83 @@ namespace nix {
 namespace hdf5 {
 
 
+static size_t attr_cache_hits = 0;
+static size_t attr_cache_misses = 0;
+
+
+size_t AttributeCache::hits() {
+    return attr_cache_hits;
+}
+
+
+size_t AttributeCache::misses() {
+    return attr_cache_misses;
+}
+
+
+void AttributeCache::resetCounters() {
+    attr_cache_hits = 0;
+    attr_cache_misses = 0;
+}
+
+
+struct AttrCacheFill {
+    unordered_map<string, string> &strings;
+    unordered_map<string, double> &numbers;
+    unordered_set<string>         *others;
+    exception_ptr error;
+};
+
+
+static herr_t cache_attribute(hid_t loc, const char *name, const H5A_info_t *info, void *op_data) {
+    auto fill = static_cast<AttrCacheFill *>(op_data);
+
+    try {
+        Attribute attr = H5Aopen(loc, name, H5P_DEFAULT);
+        attr.check("EntityHDF5: Could not open attribute " + string(name));
+
+        h5x::DataType ftype = H5Aget_type(attr.h5id());
+        H5T_class_t vclass = H5Tget_class(ftype.h5id());
+
+        // only scalar attributes are read; fixed-length strings can not be
+        // converted to the variable-length string type
+        bool scalar = attr.extent().size() == 0;
+        if (scalar && vclass == H5T_STRING && H5Tis_variable_str(ftype.h5id()) > 0) {
+            string value;
+            attr.read(data_type_to_h5_memtype(DataType::String), NDSize{}, &value);
+            fill->strings[name] = value;
+        } else if (scalar && vclass == H5T_FLOAT) {
+            double value;
+            attr.read(data_type_to_h5_memtype(DataType::Double), NDSize{}, &value);
+            fill->numbers[name] = value;
+        } else if (fill->others) {
+            fill->others->insert(name);
+        }
+    } catch (...) {
+        // exceptions must not pass through the hdf5 library
+        fill->error = current_exception();
+        return 1;
+    }
+
+    return 0;
+}
+
+
+void readScalarAttrs(hid_t object, unordered_map<string, string> &strings, unordered_map<string, double> &numbers,
+                     unordered_set<string> *others) {
+    AttrCacheFill fill{strings, numbers, others, nullptr};
+    HErr res = H5Aiterate2(object, H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, cache_attribute, &fill);
+
+    if (fill.error) {
+        rethrow_exception(fill.error);
+    }
+
+    res.check("readScalarAttrs(): Could not iterate over attributes");
+}
+
+
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const Group &group)
-    : entity_file(file), entity_group(group)
+    : entity_file(file), entity_group(group), attr_cache(file && file->attributeCache())
 {
     setUpdatedAt();
     setCreatedAt();
@@ -28,66 +105,66 @@ EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const Group &group)
 
 
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const Group &group, const string &id, time_t time)
-    : entity_file(file), entity_group(group)
+    : entity_file(file), entity_group(group), attr_cache(file && file->attributeCache())
 {
-    group.setAttr("entity_id", id);
+    setCachedAttr("entity_id", id);
     setUpdatedAt();
     forceCreatedAt(time);
 }
 
 
 string EntityHDF5::id() const {
-    string t;
-    
-    if (group().hasAttr("entity_id")) {
-        group().getAttr("entity_id", t);
-    }
-    else {
-        throw runtime_error("Entity has no id!");
+    // the id never changes once it is set, so it is always cached
+    if (entity_id.empty()) {
+        if (!getCachedAttr("entity_id", entity_id)) {
+            throw runtime_error("Entity has no id!");
+        }
+    } else {
+        attr_cache_hits++;
     }
-    
-    return t;
+
+    return entity_id;
 }
 
 
 time_t EntityHDF5::updatedAt() const {
     string t;
-    group().getAttr("updated_at", t);
+    getCachedAttr("updated_at", t);
     return util::strToTime(t);
 }
 
 
 void EntityHDF5::setUpdatedAt() {
-    if (!group().hasAttr("updated_at")) {
+    if (!hasCachedAttr("updated_at")) {
         time_t t = util::getTime();
-        group().setAttr("updated_at", util::timeToStr(t));
+        setCachedAttr("updated_at", util::timeToStr(t));
     }
 }
 
 
 void EntityHDF5::forceUpdatedAt() {
     time_t t = util::getTime();
-    group().setAttr("updated_at", util::timeToStr(t));
+    setCachedAttr("updated_at", util::timeToStr(t));
 }
 
 
 time_t EntityHDF5::createdAt() const {
     string t;
-    group().getAttr("created_at", t);
+    getCachedAttr("created_at", t);
     return util::strToTime(t);
 }
 
 
 void EntityHDF5::setCreatedAt() {
-    if (!group().hasAttr("created_at")) {
+    if (!hasCachedAttr("created_at")) {
         time_t t = util::getTime();
-        group().setAttr("created_at", util::timeToStr(t));
+        setCachedAttr("created_at", util::timeToStr(t));
     }
 }
 
 
 void EntityHDF5::forceCreatedAt(time_t t) {
-    group().setAttr("created_at", util::timeToStr(t));
+    setCachedAttr("created_at", util::timeToStr(t));
 }
 
 
@@ -101,6 +178,118 @@ std::shared_ptr<base::IFile> EntityHDF5::file() const {
 }
 
 
+shared_ptr<FileHDF5> EntityHDF5::fileHDF5() const {
+    auto f = dynamic_pointer_cast<FileHDF5>(entity_file);
+    if (!f) {
+        throw runtime_error("EntityHDF5: the entity does not belong to a HDF5 file");
+    }
+    return f;
+}
+
+
+void EntityHDF5::fillAttrCache() const {
+    cached_strings.clear();
+    cached_numbers.clear();
+    uncached.clear();
+
+    readScalarAttrs(entity_group.h5id(), cached_strings, cached_numbers, &uncached);
+    attrs_cached = true;
+}
+
+
+bool EntityHDF5::hasCachedAttr(const string &name) const {
+    if (!attrs_cached && !attr_cache) {
+        attr_cache_misses++;
+        return group().hasAttr(name);
+    }
+
+    if (attrs_cached) {
+        attr_cache_hits++;
+    } else {
+        attr_cache_misses++;
+        fillAttrCache();
+    }
+
+    return cached_strings.count(name) > 0 || cached_numbers.count(name) > 0 || uncached.count(name) > 0;
+}
+
+
+bool EntityHDF5::getCachedAttr(const string &name, string &value) const {
+    if (!attrs_cached && !attr_cache) {
+        attr_cache_misses++;
+        return group().getAttr(name, value);
+    }
+
+    if (attrs_cached) {
+        attr_cache_hits++;
+    } else {
+        attr_cache_misses++;
+        fillAttrCache();
+    }
+
+    auto it = cached_strings.find(name);
+    if (it == cached_strings.end()) {
+        return uncached.count(name) > 0 && group().getAttr(name, value);
+    }
+
+    value = it->second;
+    return true;
+}
+
+
+bool EntityHDF5::getCachedAttr(const string &name, double &value) const {
+    if (!attrs_cached && !attr_cache) {
+        attr_cache_misses++;
+        return group().getAttr(name, value);
+    }
+
+    if (attrs_cached) {
+        attr_cache_hits++;
+    } else {
+        attr_cache_misses++;
+        fillAttrCache();
+    }
+
+    auto it = cached_numbers.find(name);
+    if (it == cached_numbers.end()) {
+        return uncached.count(name) > 0 && group().getAttr(name, value);
+    }
+
+    value = it->second;
+    return true;
+}
+
+
+void EntityHDF5::setCachedAttr(const string &name, const string &value) {
+    group().setAttr(name, value);
+
+    // an existing attribute keeps its type, so uncached ones stay uncached
+    if (attrs_cached && uncached.count(name) == 0) {
+        cached_strings[name] = value;
+    }
+}
+
+
+void EntityHDF5::setCachedAttr(const string &name, double value) {
+    group().setAttr(name, value);
+
+    if (attrs_cached && uncached.count(name) == 0) {
+        cached_numbers[name] = value;
+    }
+}
+
+
+void EntityHDF5::removeCachedAttr(const string &name) {
+    if (group().hasAttr(name)) {
+        group().removeAttr(name);
+    }
+
+    cached_strings.erase(name);
+    cached_numbers.erase(name);
+    uncached.erase(name);
+}
+
+
 bool EntityHDF5::operator==(const EntityHDF5 &other) const {
     return group() == other.group() && id() == other.id();
 }
@@ -81,6 +81,20 @@ shared_ptr<ISource> EntityWithSourcesHDF5::getSource(const size_t index) const {
     return getSource(id);
 }
 
+vector<shared_ptr<ISource>> EntityWithSourcesHDF5::getSources(const util::Match &match) const {
+    vector<shared_ptr<ISource>> entities;
+    boost::optional<Group> g = sources_refs();
+
+    if (g) {
+        for (const auto &group : g->groups(match, util::Match::Field::Id)) {
+            entities.push_back(make_shared<SourceHDF5>(file(), group));
+        }
+    }
+
+    return entities;
+}
+
+
 void EntityWithSourcesHDF5::sources(const std::vector<Source> &sources) {
     // extract vectors of ids from vectors of new & old sources
     std::vector<std::string> ids_new(sources.size());
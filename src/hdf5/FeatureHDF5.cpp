@@ -11,6 +11,7 @@
 #include <nix/util/util.hpp>
 #include <nix/DataArray.hpp>
 #include <nix/hdf5/DataArrayHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 
 
 using namespace std;
@@ -79,6 +80,7 @@ void FeatureHDF5::data(const std::string &name_or_id) {
     auto target = dynamic_pointer_cast<DataArrayHDF5>(block->getDataArray(name_or_id));
 
     group().createLink(target->group(), "data");
+    fileHDF5()->referenceIndex(block->name()).setFeatureData(id(), target->id());
     forceUpdatedAt();
 }
 
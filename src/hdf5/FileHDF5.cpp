@@ -11,9 +11,12 @@
 #include <nix/util/util.hpp>
 #include <nix/hdf5/BlockHDF5.hpp>
 #include <nix/hdf5/SectionHDF5.hpp>
+#include <nix/hdf5/EntityHDF5.hpp>
+#include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/ExceptionHDF5.hpp>
 
 #include <fstream>
+#include <unordered_map>
 #include <vector>
 #include <ctime>
 
@@ -46,12 +49,14 @@ static unsigned int map_file_mode(FileMode mode) {
 }
 
 
-FileHDF5::FileHDF5(const string &name, FileMode mode)
+FileHDF5::FileHDF5(const string &name, FileMode mode, const ChunkCache &cache)
 {
     if (!fileExists(name)) {
         mode = FileMode::Overwrite;
     }
     this->mode = mode;
+    // nothing can change the attributes of a read-only file
+    attr_cache = mode == FileMode::ReadOnly;
     //we want hdf5 to keep track of the order in which links were created so that
     //the order for indexed based accessors is stable cf. issue #387
     BaseHDF5 fcpl = H5Pcreate(H5P_FILE_CREATE);
@@ -59,12 +64,17 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
     HErr res = H5Pset_link_creation_order(fcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
     res.check("Unable to create file (H5Pset_link_creation_order failed.)");
 
+    BaseHDF5 fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    res = H5Pset_cache(fapl.h5id(), 0, cache.slots, cache.bytes, cache.preemption);
+    res.check("Unable to open file (H5Pset_cache failed.)");
+
     unsigned int h5mode =  map_file_mode(mode);
 
     if (h5mode & H5F_ACC_TRUNC) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), h5mode, fapl.h5id());
     }
 
     if (!H5Iis_valid(hid)) {
@@ -76,6 +86,7 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
 
     metadata = root.openGroup("metadata");
     data = root.openGroup("data");
+    section_index.reset(new TreeIndex(metadata, "sections"));
 
     setCreatedAt();
     setUpdatedAt();
@@ -112,6 +123,22 @@ shared_ptr<base::IBlock> FileHDF5::getBlock(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<base::IBlock>> FileHDF5::getBlocks(const util::Match &match) const {
+    vector<shared_ptr<base::IBlock>> entities;
+
+    for (const auto &group : data.groups(match)) {
+        entities.push_back(make_shared<BlockHDF5>(file(), group));
+    }
+
+    return entities;
+}
+
+
+vector<string> FileHDF5::blockKeys(const util::Match &match) const {
+    return data.matchingLinks(match, util::Match::Field::Name);
+}
+
+
 shared_ptr<base::IBlock> FileHDF5::createBlock(const string &name, const string &type) {
     string id = util::createId();
     Group group = data.openGroup(name, true);
@@ -124,7 +151,10 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
 
     if (hasBlock(name_or_id)) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = data.removeAllLinks(getBlock(name_or_id)->name());
+        string name = getBlock(name_or_id)->name();
+        deleted = data.removeAllLinks(name);
+        source_indexes.erase(name);
+        reference_indexes.erase(name);
     }
 
     return deleted;
@@ -163,11 +193,29 @@ shared_ptr<base::ISection> FileHDF5::getSection(ndsize_t index) const{
 }
 
 
+vector<shared_ptr<base::ISection>> FileHDF5::getSections(const util::Match &match) const {
+    vector<shared_ptr<base::ISection>> entities;
+
+    for (const auto &group : metadata.groups(match)) {
+        entities.push_back(make_shared<SectionHDF5>(file(), group));
+    }
+
+    return entities;
+}
+
+
+vector<string> FileHDF5::sectionKeys(const util::Match &match) const {
+    return metadata.matchingLinks(match, util::Match::Field::Name);
+}
+
+
 shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  string &type) {
     string id = util::createId();
 
     Group group = metadata.openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), group, id, type, name);
+    auto section = make_shared<SectionHDF5>(file(), group, id, type, name);
+    sectionIndex().add("", id, name, type);
+    return section;
 }
 
 
@@ -184,6 +232,7 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
         }
         // if hasSection is true then section_group always exists
         deleted = metadata.removeAllLinks(section.name());
+        sectionIndex().remove(section.id());
     }
 
     return deleted;
@@ -195,6 +244,224 @@ ndsize_t FileHDF5::sectionCount() const {
 }
 
 
+vector<shared_ptr<base::ISection>> FileHDF5::findSections(const util::Match &match, size_t max_depth) const {
+    vector<shared_ptr<base::ISection>> entities;
+    SectionMap opened;
+
+    for (const TreeIndex::Entry *entry : sectionIndex().find(match, nullptr, max_depth)) {
+        entities.push_back(openSection(*entry, opened));
+    }
+
+    return entities;
+}
+
+
+TreeIndex *FileHDF5::sourceIndex(const string &block) const {
+    auto it = source_indexes.find(block);
+    if (it != source_indexes.end()) {
+        return it->second.get();
+    }
+
+    string path = block + "/sources";
+    if (!data.hasObject(path)) {
+        return nullptr;
+    }
+
+    TreeIndex *index = new TreeIndex(data.openGroup(block).openGroup("sources"), "sources");
+    source_indexes[block].reset(index);
+    return index;
+}
+
+
+ReferenceIndex &FileHDF5::referenceIndex(const string &block) const {
+    unique_ptr<ReferenceIndex> &index = reference_indexes[block];
+    if (!index) {
+        index.reset(new ReferenceIndex(data.openGroup(block, false)));
+    }
+    return *index;
+}
+
+
+TreeIndex &FileHDF5::sectionIndex() const {
+    if (!section_index) {
+        throw runtime_error("FileHDF5::sectionIndex: the file is closed");
+    }
+    return *section_index;
+}
+
+
+shared_ptr<base::ISection> FileHDF5::openSection(const TreeIndex::Entry &entry,
+                                                 const shared_ptr<base::ISection> &ancestor) const {
+    SectionMap opened;
+    if (ancestor) {
+        opened.emplace(ancestor->id(), ancestor);
+    }
+    return openSection(entry, opened);
+}
+
+
+shared_ptr<base::ISection> FileHDF5::openSection(const TreeIndex::Entry &entry, SectionMap &opened) const {
+    auto it = opened.find(entry.id);
+    if (it != opened.end()) {
+        return it->second;
+    }
+
+    shared_ptr<base::ISection> parent;
+    if (!entry.parent.empty()) {
+        const TreeIndex::Entry *parent_entry = sectionIndex().find(entry.parent);
+        if (!parent_entry) {
+            throw runtime_error("FileHDF5::openSection: parent section not found in the index");
+        }
+        parent = openSection(*parent_entry, opened);
+    }
+
+    auto section = make_shared<SectionHDF5>(file(), parent, sectionIndex().open(entry));
+    opened.emplace(entry.id, section);
+    return section;
+}
+
+
+namespace {
+
+// Reads the metadata tree depth first; every object is opened once and its
+// attributes are read in a single iteration.
+struct MetadataTreeLoader {
+    MetadataTree::Data                    &data;
+    vector<pair<size_t, string>>          links;      // section, id of the linked section
+    unordered_map<string, string>         strings;
+    unordered_map<string, double>         numbers;
+
+    explicit MetadataTreeLoader(MetadataTree::Data &data)
+        : data(data)
+    {}
+
+
+    void readAttrs(hid_t object) {
+        strings.clear();
+        numbers.clear();
+        readScalarAttrs(object, strings, numbers);
+    }
+
+
+    const string *optional(const char *name) {
+        auto it = strings.find(name);
+        return it == strings.end() ? nullptr : data.intern(it->second);
+    }
+
+
+    const string *required(const char *name, const string &fallback) {
+        auto it = strings.find(name);
+        return data.intern(it == strings.end() ? fallback : it->second);
+    }
+
+
+    time_t time(const char *name) {
+        auto it = strings.find(name);
+        return it == strings.end() ? 0 : util::strToTime(it->second);
+    }
+
+
+    size_t section(const Group &group, const string &name, size_t parent) {
+        // nodes are only referred to by index, the arena may grow below
+        size_t index = data.sections.size();
+        data.sections.emplace_back();
+
+        readAttrs(group.h5id());
+        MetadataTree::SectionNode &node = data.sections[index];
+        node.id = required("entity_id", "");
+        node.name = required("name", name);
+        node.type = required("type", "");
+        node.definition = optional("definition");
+        node.repository = optional("repository");
+        node.mapping = optional("mapping");
+        node.created_at = time("created_at");
+        node.updated_at = time("updated_at");
+        node.parent = parent;
+        data.section_ids.emplace(*node.id, index);
+
+        group.visitObjects([&](const string &child_name, H5O_type_t type, const LocID &obj) {
+            if (type != H5O_TYPE_GROUP) {
+                return true;
+            }
+
+            Group child(obj.h5id(), true);
+            if (child_name == "sections") {
+                child.visitObjects([&](const string &sec_name, H5O_type_t sec_type, const LocID &sec) {
+                    if (sec_type == H5O_TYPE_GROUP) {
+                        size_t sub = section(Group(sec.h5id(), true), sec_name, index);
+                        data.sections[index].sections.push_back(sub);
+                    }
+                    return true;
+                });
+            } else if (child_name == "properties") {
+                child.visitObjects([&](const string &prop_name, H5O_type_t prop_type, const LocID &prop) {
+                    if (prop_type == H5O_TYPE_DATASET) {
+                        size_t p = property(DataSet(prop.h5id(), true), prop_name, index);
+                        data.sections[index].properties.push_back(p);
+                    }
+                    return true;
+                });
+            } else if (child_name == "link") {
+                string id;
+                if (child.getAttr("entity_id", id)) {
+                    links.emplace_back(index, id);
+                }
+            }
+            return true;
+        });
+
+        return index;
+    }
+
+
+    size_t property(const DataSet &dataset, const string &name, size_t section) {
+        size_t index = data.properties.size();
+        data.properties.emplace_back();
+
+        readAttrs(dataset.h5id());
+        MetadataTree::PropertyNode &node = data.properties[index];
+        node.id = required("entity_id", "");
+        node.name = required("name", name);
+        node.definition = optional("definition");
+        node.unit = optional("unit");
+        node.mapping = optional("mapping");
+        node.created_at = time("created_at");
+        node.updated_at = time("updated_at");
+        node.section = section;
+
+        dataset.read(node.values);
+        node.data_type = node.values.empty() ? dataset.dataType() : node.values.front().type();
+
+        return index;
+    }
+};
+
+} // anonymous namespace
+
+
+shared_ptr<MetadataTree::Data> FileHDF5::loadMetadataTree() const {
+    auto data = make_shared<MetadataTree::Data>();
+    MetadataTreeLoader loader(*data);
+
+    metadata.visitObjects([&](const string &name, H5O_type_t type, const LocID &obj) {
+        if (type == H5O_TYPE_GROUP) {
+            data->roots.push_back(loader.section(Group(obj.h5id(), true), name, MetadataTree::npos));
+        }
+        return true;
+    });
+
+    // links may point to sections that are read later
+    for (const auto &link : loader.links) {
+        auto it = data->section_ids.find(link.second);
+        if (it != data->section_ids.end()) {
+            data->sections[link.first].link = it->second;
+        }
+    }
+
+    return data;
+}
+
+
 //--------------------------------------------------
 // Local attributes
 //--------------------------------------------------
@@ -277,6 +544,11 @@ void FileHDF5::close() {
     if (!isOpen())
         return;
 
+    root.releaseIndexes();
+    section_index.reset();
+    source_indexes.clear();
+    reference_indexes.clear();
+
     data.close();
     metadata.close();
     root.close();
@@ -321,6 +593,16 @@ FileMode FileHDF5::fileMode() const {
 }
 
 
+void FileHDF5::attributeCache(bool enabled) {
+    attr_cache = enabled;
+}
+
+
+bool FileHDF5::attributeCache() const {
+    return attr_cache;
+}
+
+
 shared_ptr<base::IFile> FileHDF5::file() const {
     return  const_pointer_cast<FileHDF5>(shared_from_this());
 }
@@ -12,10 +12,203 @@
 
 #include <nix/hdf5/ExceptionHDF5.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
 
 namespace nix {
 namespace hdf5 {
 
+
+/**
+ * Cached mapping from the value of an attribute to the name of the link
+ * that points to the child object carrying it, for one group.
+ */
+struct LinkIndex {
+    bool built = false;
+    // attribute value -> link name
+    std::unordered_map<std::string, std::string> links;
+    // link name -> attribute value, for the links in links
+    std::unordered_map<std::string, std::string> values;
+    // link names that have been inspected already
+    std::unordered_set<std::string> known;
+    // link names whose objects did not carry the attribute when inspected;
+    // they are inspected once more on the next miss
+    std::vector<std::string> pending;
+    // link names that did not carry the attribute on the second inspection
+    // either; inspected again only when links are added to the group
+    std::vector<std::string> bare;
+};
+
+// (file number, object address, attribute name)
+typedef std::tuple<unsigned long, haddr_t, std::string> IndexKey;
+
+// the indexes are shared by all Group handles and therefore by all threads
+static std::mutex link_index_mutex;
+
+
+static std::map<IndexKey, LinkIndex> &link_indexes() {
+    static std::map<IndexKey, LinkIndex> indexes;
+    return indexes;
+}
+
+
+static herr_t collect_link_name(hid_t group, const char *name, const H5L_info_t *info, void *op_data) {
+    auto names = static_cast<std::vector<std::string> *>(op_data);
+    names->emplace_back(name);
+    return 0;
+}
+
+
+struct VisitState {
+    const std::function<bool(const std::string &, H5O_type_t, const LocID &)> &visitor;
+    std::exception_ptr error;
+};
+
+
+static herr_t visit_object(hid_t group, const char *name, const H5L_info_t *info, void *op_data) {
+    auto state = static_cast<VisitState *>(op_data);
+
+    try {
+        LocID obj = H5Oopen(group, name, H5P_DEFAULT);
+        if (!obj.isValid()) {
+            return 0;
+        }
+
+        H5O_type_t type;
+        switch (H5Iget_type(obj.h5id())) {
+            case H5I_GROUP:    type = H5O_TYPE_GROUP; break;
+            case H5I_DATASET:  type = H5O_TYPE_DATASET; break;
+            case H5I_DATATYPE: type = H5O_TYPE_NAMED_DATATYPE; break;
+            default:           type = H5O_TYPE_UNKNOWN; break;
+        }
+
+        // a positive return value stops the iteration
+        return state->visitor(name, type, obj) ? 0 : 1;
+    } catch (...) {
+        // exceptions must not pass through the hdf5 library
+        state->error = std::current_exception();
+        return 1;
+    }
+}
+
+
+static bool read_link_attr(hid_t hid, const std::string &name, const std::string &attribute, std::string &value) {
+    LocID obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+    if (!obj.isValid()) {
+        return false;
+    }
+
+    return obj.getAttr(attribute, value);
+}
+
+
+static bool index_link(LinkIndex &idx, hid_t hid, const std::string &name, const std::string &attribute) {
+    std::string value;
+    if (!read_link_attr(hid, name, attribute, value)) {
+        return false;
+    }
+
+    idx.links.emplace(value, name);
+    idx.values[name] = value;
+    return true;
+}
+
+
+static void forget_link(LinkIndex &idx, const std::string &name) {
+    auto value = idx.values.find(name);
+    if (value != idx.values.end()) {
+        auto link = idx.links.find(value->second);
+        if (link != idx.links.end() && link->second == name) {
+            idx.links.erase(link);
+        }
+        idx.values.erase(value);
+    }
+
+    idx.known.erase(name);
+    idx.pending.erase(std::remove(idx.pending.begin(), idx.pending.end(), name), idx.pending.end());
+    idx.bare.erase(std::remove(idx.bare.begin(), idx.bare.end(), name), idx.bare.end());
+}
+
+
+static void refresh_index(LinkIndex &idx, hid_t hid, const std::string &attribute) {
+    std::vector<std::string> names;
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, collect_link_name, &names);
+    res.check("Group::refresh_index(): Could not iterate over links");
+
+    if (idx.built) {
+        // links that were removed without linkRemoved(), e.g. by other programs
+        std::unordered_set<std::string> current(names.begin(), names.end());
+        std::vector<std::string> gone;
+        for (const auto &name : idx.known) {
+            if (current.count(name) == 0) {
+                gone.push_back(name);
+            }
+        }
+        for (const auto &name : gone) {
+            forget_link(idx, name);
+        }
+
+        // objects may have been given the attribute in the meantime
+        std::vector<std::string> bare;
+        bare.swap(idx.bare);
+        for (const auto &name : bare) {
+            if (!index_link(idx, hid, name, attribute)) {
+                idx.bare.push_back(name);
+            }
+        }
+    }
+
+    for (const auto &name : names) {
+        if (idx.known.insert(name).second && !index_link(idx, hid, name, attribute)) {
+            idx.pending.push_back(name);
+        }
+    }
+
+    idx.built = true;
+}
+
+
+static boost::optional<std::string> lookup_index(LinkIndex &idx, hid_t hid, const std::string &attribute,
+                                                 const std::string &value) {
+    boost::optional<std::string> ret;
+    std::string attr_value;
+
+    auto it = idx.links.find(value);
+    if (it != idx.links.end()) {
+        HTri exists = H5Lexists(hid, it->second.c_str(), H5P_DEFAULT);
+        if (exists.check("Group::lookup_index(): H5Lexists failed") &&
+            read_link_attr(hid, it->second, attribute, attr_value) && attr_value == value) {
+            ret = it->second;
+            return ret;
+        }
+        // the link was changed outside of Group; inspect it again later
+        std::string name = it->second;
+        forget_link(idx, name);
+    }
+
+    // objects that got the attribute only after they were indexed
+    std::vector<std::string> pending;
+    pending.swap(idx.pending);
+    for (const auto &name : pending) {
+        if (!index_link(idx, hid, name, attribute)) {
+            idx.bare.push_back(name);
+        }
+    }
+
+    it = idx.links.find(value);
+    if (it != idx.links.end()) {
+        ret = it->second;
+    }
+
+    return ret;
+}
+
 optGroup::optGroup(const Group &parent, const std::string &g_name)
     : parent(parent), g_name(g_name)
 {}
@@ -79,7 +272,8 @@ boost::optional<Group> Group::findGroupByAttribute(const std::string &attribute,
     boost::optional<Group> ret;
 
     // look up first direct sub-group that has given attribute with given value
-    for (ndsize_t index = 0; index < objectCount(); index++) {
+    const ndsize_t count = objectCount();
+    for (ndsize_t index = 0; index < count; index++) {
         std::string obj_name = objectName(index);
         if(hasGroup(obj_name)) {
             Group group = openGroup(obj_name, false);
@@ -103,7 +297,8 @@ boost::optional<DataSet> Group::findDataByAttribute(const std::string &attribute
     boost::optional<DataSet> ret;
 
     // look up all direct sub-datasets that have the given attribute
-    for (ndsize_t index = 0; index < objectCount(); index++) {
+    const ndsize_t count = objectCount();
+    for (ndsize_t index = 0; index < count; index++) {
         std::string obj_name = objectName(index);
         if(hasData(obj_name)) {
             DataSet ds = openData(obj_name);
@@ -125,6 +320,152 @@ boost::optional<DataSet> Group::findDataByAttribute(const std::string &attribute
 }
 
 
+void Group::visitObjects(const std::function<bool(const std::string &, H5O_type_t, const LocID &)> &visitor) const {
+    VisitState state{visitor, nullptr};
+
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, visit_object, &state);
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+
+    res.check("Group::visitObjects(): Could not iterate over links");
+}
+
+
+std::vector<Group> Group::groups() const {
+    std::vector<Group> result;
+
+    visitObjects([&result](const std::string &name, H5O_type_t type, const LocID &obj) {
+        if (type == H5O_TYPE_GROUP) {
+            result.emplace_back(obj.h5id(), true);
+        }
+        return true;
+    });
+
+    return result;
+}
+
+
+std::vector<DataSet> Group::dataSets() const {
+    std::vector<DataSet> result;
+
+    visitObjects([&result](const std::string &name, H5O_type_t type, const LocID &obj) {
+        if (type == H5O_TYPE_DATASET) {
+            result.emplace_back(obj.h5id(), true);
+        }
+        return true;
+    });
+
+    return result;
+}
+
+
+static const char *match_attribute(util::Match::Field field) {
+    switch (field) {
+        case util::Match::Field::Name: return "name";
+        case util::Match::Field::Id:   return "entity_id";
+        case util::Match::Field::Type: return "type";
+        default:                       return nullptr;
+    }
+}
+
+
+static bool is_link_name(const std::string &value) {
+    return !value.empty() && value.find('/') == std::string::npos && value != "." && value != "..";
+}
+
+
+std::vector<std::string> Group::matchingLinks(const util::Match &match, util::Match::Field link_field) const {
+    std::vector<std::string> names;
+
+    // a single name can be looked up directly
+    if (match.field == link_field && match.values.size() == 1) {
+        const std::string &value = *match.values.begin();
+        if (is_link_name(value) && hasObject(value)) {
+            names.push_back(value);
+        }
+        return names;
+    }
+
+    std::unordered_set<std::string> selected;
+    bool by_index = match.field == util::Match::Field::Id && link_field == util::Match::Field::Name;
+
+    if (by_index) {
+        for (const auto &value : match.values) {
+            boost::optional<std::string> name = findLinkByAttribute("entity_id", value);
+            if (name) {
+                selected.insert(*name);
+            }
+        }
+
+        if (selected.size() < 2) {
+            names.assign(selected.begin(), selected.end());
+            return names;
+        }
+    }
+
+    // bring the selection into link order
+    std::vector<std::string> links;
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, collect_link_name, &links);
+    res.check("Group::matchingLinks(): Could not iterate over links");
+
+    const char *attribute = match_attribute(match.field);
+    std::string value;
+
+    for (const auto &name : links) {
+        bool accept;
+        if (match.field == util::Match::Field::All || match.field == link_field) {
+            accept = match.accepts(name);
+        } else if (by_index) {
+            accept = selected.count(name) > 0;
+        } else {
+            accept = read_link_attr(hid, name, attribute, value) && match.accepts(value);
+        }
+
+        if (accept) {
+            names.push_back(name);
+        }
+    }
+
+    return names;
+}
+
+
+std::vector<Group> Group::groups(const util::Match &match, util::Match::Field link_field) const {
+    if (match.field == util::Match::Field::All) {
+        return groups();
+    }
+
+    std::vector<Group> result;
+    for (const auto &name : matchingLinks(match, link_field)) {
+        LocID obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+        if (obj.isValid() && H5Iget_type(obj.h5id()) == H5I_GROUP) {
+            result.emplace_back(obj.h5id(), true);
+        }
+    }
+
+    return result;
+}
+
+
+std::vector<DataSet> Group::dataSets(const util::Match &match, util::Match::Field link_field) const {
+    if (match.field == util::Match::Field::All) {
+        return dataSets();
+    }
+
+    std::vector<DataSet> result;
+    for (const auto &name : matchingLinks(match, link_field)) {
+        LocID obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+        if (obj.isValid() && H5Iget_type(obj.h5id()) == H5I_DATASET) {
+            result.emplace_back(obj.h5id(), true);
+        }
+    }
+
+    return result;
+}
+
+
 std::string Group::objectName(ndsize_t index) const {
     // check if index valid
     if(index > objectCount()) {
@@ -170,17 +511,44 @@ bool Group::hasData(const std::string &name) const {
 
 void Group::removeData(const std::string &name) {
     if (hasData(name)) {
+        linkRemoved(name);
         HErr res = H5Gunlink(hid, name.c_str());
         res.check("Group::removeData(): Could not unlink DataSet");
     }
 }
 
+static void set_filters(const BaseHDF5 &dcpl, const Compression &compression) {
+    HErr res;
+
+    if (compression.shuffle) {
+        res = H5Pset_shuffle(dcpl.h5id());
+        res.check("Could not set shuffle filter on data set creation plist");
+    }
+
+    if (compression.deflate >= 0) {
+        if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+            throw std::runtime_error("Group::createData: The deflate filter is not available");
+        }
+
+        res = H5Pset_deflate(dcpl.h5id(), static_cast<unsigned>(compression.deflate));
+        res.check("Could not set deflate filter on data set creation plist");
+    }
+
+    if (compression.fletcher32) {
+        res = H5Pset_fletcher32(dcpl.h5id());
+        res.check("Could not set fletcher32 filter on data set creation plist");
+    }
+}
+
+
 DataSet Group::createData(const std::string &name,
         DataType dtype,
-        const NDSize &size) const
+        const NDSize &size,
+        const Compression &compression,
+        const NDSize &chunks) const
 {
     h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-    return createData(name, fileType, size);
+    return createData(name, fileType, size, {}, chunks, true, true, compression);
 }
 
 
@@ -190,7 +558,8 @@ DataSet Group::createData(const std::string &name,
         const NDSize &maxsize,
         NDSize chunks,
         bool max_size_unlimited,
-        bool guess_chunks) const
+        bool guess_chunks,
+        const Compression &compression) const
 {
     DataSpace space;
 
@@ -215,6 +584,14 @@ DataSet Group::createData(const std::string &name,
         res.check("Could not set chunk size on data set creation plist");
     }
 
+    if (compression.enabled()) {
+        if (!chunks) {
+            throw std::invalid_argument("Group::createData: Filters can only be used with chunked data");
+        }
+
+        set_filters(dcpl, compression);
+    }
+
     DataSet ds = H5Dcreate(hid, name.c_str(), fileType.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
     ds.check("Group::createData: Could not create DataSet with name " + name);
 
@@ -229,6 +606,19 @@ DataSet Group::openData(const std::string &name) const {
 }
 
 
+DataSet Group::openData(const std::string &name, const ChunkCache &cache) const {
+    BaseHDF5 dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    dapl.check("Group::openData(): Could not create data access plist");
+
+    HErr res = H5Pset_chunk_cache(dapl.h5id(), cache.slots, cache.bytes, cache.preemption);
+    res.check("Group::openData(): Could not set chunk cache");
+
+    DataSet ds = H5Dopen(hid, name.c_str(), dapl.h5id());
+    ds.check("Group::openData(): Could not open DataSet");
+    return ds;
+}
+
+
 bool Group::hasGroup(const std::string &name) const {
     return hasObject(name) && objectOfType(name, H5O_TYPE_GROUP);
 }
@@ -269,8 +659,10 @@ optGroup Group::openOptGroup(const std::string &name) {
 
 
 void Group::removeGroup(const std::string &name) {
-    if (hasGroup(name))
+    if (hasGroup(name)) {
+        linkRemoved(name);
         H5Gunlink(hid, name.c_str());
+    }
 }
 
 
@@ -278,6 +670,7 @@ void Group::renameGroup(const std::string &old_name, const std::string &new_name
     check_h5_arg_name(new_name);
 
     if (hasGroup(old_name)) {
+        linkRemoved(old_name);
         H5Gmove(hid, old_name.c_str(), new_name.c_str()); //FIXME: H5Gmove is deprecated
     }
 }
@@ -305,6 +698,7 @@ bool Group::renameAllLinks(const std::string &old_name, const std::string &new_n
         std::string gname = group.name();
 
         while (! gname.empty()) {
+            linkRemoved(gname);
             deleteLink(gname);
             links.push_back(gname);
             gname = group.name();
@@ -337,6 +731,7 @@ bool Group::removeAllLinks(const std::string &name) {
         std::string gname = group.name();
 
         while (! gname.empty()) {
+            linkRemoved(gname);
             deleteLink(gname);
             gname = group.name();
         }
@@ -353,10 +748,13 @@ boost::optional<Group> Group::findGroupByNameOrAttribute(std::string const &attr
     if (hasObject(value)) {
         return boost::make_optional(openGroup(value, false));
     } else if (util::looksLikeUUID(value)) {
-        return findGroupByAttribute(attr, value);
-    } else {
-        return boost::optional<Group>();
+        boost::optional<std::string> name = findLinkByAttribute(attr, value);
+        if (name && hasGroup(*name)) {
+            return boost::make_optional(openGroup(*name, false));
+        }
     }
+
+    return boost::optional<Group>();
 }
 
 
@@ -365,10 +763,81 @@ boost::optional<DataSet> Group::findDataByNameOrAttribute(std::string const &att
     if (hasObject(value)) {
         return boost::make_optional(openData(value));
     } else if (util::looksLikeUUID(value)) {
-        return findDataByAttribute(attr, value);
-    } else {
-        return boost::optional<DataSet>();
+        boost::optional<std::string> name = findLinkByAttribute(attr, value);
+        if (name && hasData(*name)) {
+            return boost::make_optional(openData(*name));
+        }
+    }
+
+    return boost::optional<DataSet>();
+}
+
+
+boost::optional<std::string> Group::findLinkByAttribute(const std::string &attribute, const std::string &value) const {
+    H5O_info_t info;
+    HErr err = H5Oget_info(hid, &info);
+    err.check("Group::findLinkByAttribute(): Could not obtain object info");
+
+    std::lock_guard<std::mutex> lock(link_index_mutex);
+    LinkIndex &idx = link_indexes()[IndexKey(info.fileno, info.addr, attribute)];
+
+    if (!idx.built) {
+        refresh_index(idx, hid, attribute);
+    }
+
+    boost::optional<std::string> name = lookup_index(idx, hid, attribute, value);
+
+    // removed links are dropped from the index by linkRemoved(), so a
+    // different count means that links were added
+    if (!name && objectCount() != idx.known.size()) {
+        refresh_index(idx, hid, attribute);
+        auto it = idx.links.find(value);
+        if (it != idx.links.end()) {
+            name = it->second;
+        }
     }
+
+    return name;
+}
+
+
+void Group::linkRemoved(const std::string &path) const {
+    // the indexes of the group that holds the link, which is not
+    // necessarily this group if path has several components
+    size_t pos = path.find_last_of('/');
+    std::string parent = pos == std::string::npos ? "." : (pos == 0 ? "/" : path.substr(0, pos));
+    std::string name = pos == std::string::npos ? path : path.substr(pos + 1);
+
+    H5O_info_t info;
+    HErr err = H5Oget_info_by_name(hid, parent.c_str(), &info, H5P_DEFAULT);
+    if (err.isError()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(link_index_mutex);
+    auto &indexes = link_indexes();
+    for (auto it = indexes.lower_bound(IndexKey(info.fileno, info.addr, std::string()));
+         it != indexes.end() && std::get<0>(it->first) == info.fileno && std::get<1>(it->first) == info.addr;
+         ++it) {
+        forget_link(it->second, name);
+    }
+}
+
+
+void Group::releaseIndexes() const {
+    H5O_info_t info;
+    HErr err = H5Oget_info(hid, &info);
+    err.check("Group::releaseIndexes(): Could not obtain object info");
+
+    std::lock_guard<std::mutex> lock(link_index_mutex);
+    auto &indexes = link_indexes();
+    auto first = indexes.lower_bound(IndexKey(info.fileno, 0, std::string()));
+    auto last = first;
+    while (last != indexes.end() && std::get<0>(last->first) == info.fileno) {
+        ++last;
+    }
+
+    indexes.erase(first, last);
 }
 
 
@@ -78,6 +78,7 @@ void MultiTagHDF5::positions(const string &name_or_id) {
     auto target = dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
     group().createLink(target->group(), "positions");
+    referenceIndex().set(referrer(ReferenceIndex::Role::Positions), target->id());
     forceUpdatedAt();
 }
 
@@ -111,8 +112,11 @@ shared_ptr<IDataArray>  MultiTagHDF5::extents() const {
 void MultiTagHDF5::extents(const string &name_or_id) {
     if (!block()->hasDataArray(name_or_id))
         throw std::runtime_error("MultiTagHDF5::extents: DataArray not found in block!");
-    if (group().hasGroup("extents"))
+    if (group().hasGroup("extents")) {
         group().removeGroup("extents");
+        // the old extents are gone even if the new ones are rejected below
+        referenceIndex().set(referrer(ReferenceIndex::Role::Extents), "");
+    }
 
     auto da = block()->getDataArray(name_or_id);
     if (!checkDimensions(da, positions()))
@@ -120,12 +124,14 @@ void MultiTagHDF5::extents(const string &name_or_id) {
     auto target = dynamic_pointer_cast<DataArrayHDF5>(da);
 
     group().createLink(target->group(), "extents");
+    referenceIndex().set(referrer(ReferenceIndex::Role::Extents), target->id());
     forceUpdatedAt();
 }
 
 void MultiTagHDF5::extents(const none_t t) {
     if (group().hasGroup("extents")) {
         group().removeGroup("extents");
+        referenceIndex().set(referrer(ReferenceIndex::Role::Extents), "");
     }
     forceUpdatedAt();
 }
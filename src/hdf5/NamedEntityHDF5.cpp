@@ -42,7 +42,7 @@ NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const Group
     if (name.empty()) {
         throw EmptyString("name");
     } else {
-        group.setAttr("name", name);
+        setCachedAttr("name", name);
         forceUpdatedAt();
     }
 
@@ -53,7 +53,7 @@ void NamedEntityHDF5::type(const string &type) {
     if (type.empty()) {
         throw EmptyString("type");
     } else {
-        group().setAttr("type", type);
+        setCachedAttr("type", type);
         forceUpdatedAt();
     }
 }
@@ -61,8 +61,7 @@ void NamedEntityHDF5::type(const string &type) {
 
 string NamedEntityHDF5::type() const {
     string type;
-    if (group().hasAttr("type")) {
-        group().getAttr("type", type);
+    if (getCachedAttr("type", type)) {
         return type;
     } else {
         throw MissingAttr("type");
@@ -72,8 +71,7 @@ string NamedEntityHDF5::type() const {
 
 string NamedEntityHDF5::name() const {
     string name;
-    if (group().hasAttr("name")) {
-        group().getAttr("name", name);
+    if (getCachedAttr("name", name)) {
         return name;
     } else {
         throw MissingAttr("name");
@@ -85,7 +83,7 @@ void NamedEntityHDF5::definition(const string &definition) {
     if (definition.empty()) {
         throw EmptyString("definition");
     } else {
-        group().setAttr("definition", definition);
+        setCachedAttr("definition", definition);
         forceUpdatedAt();
     }
 }
@@ -94,7 +92,7 @@ void NamedEntityHDF5::definition(const string &definition) {
 boost::optional<string> NamedEntityHDF5::definition() const {
     boost::optional<string> ret;
     string definition;
-    bool have_attr = group().getAttr("definition", definition);
+    bool have_attr = getCachedAttr("definition", definition);
     if (have_attr) {
         ret = definition;
     }
@@ -103,9 +101,7 @@ boost::optional<string> NamedEntityHDF5::definition() const {
 
 
 void NamedEntityHDF5::definition(const nix::none_t t) {
-    if (group().hasAttr("definition")) {
-        group().removeAttr("definition");
-    }
+    removeCachedAttr("definition");
     forceUpdatedAt();
 }
 
@@ -146,7 +146,10 @@ void PropertyHDF5::definition(const nix::none_t t) {
 
 
 DataType PropertyHDF5::dataType() const {
-    return this->dataset().dataType();
+    if (data_type == DataType::Nothing) {
+        data_type = this->dataset().dataType();
+    }
+    return data_type;
 }
 
 
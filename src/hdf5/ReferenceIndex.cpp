@@ -0,0 +1,248 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/ReferenceIndex.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+ReferenceIndex::ReferenceIndex(const Group &block)
+    : block(block), built(false)
+{}
+
+
+string ReferenceIndex::slot(const Referrer &referrer) {
+    switch (referrer.role) {
+        case Role::Feature:
+            return referrer.feature_id;
+        case Role::Positions:
+            return referrer.tag_id + "/positions";
+        case Role::Extents:
+            return referrer.tag_id + "/extents";
+        default:
+            return "";
+    }
+}
+
+
+void ReferenceIndex::insert(const string &array_id, const Referrer &referrer) const {
+    vector<Referrer> &list = referrers[array_id];
+    if (std::find(list.begin(), list.end(), referrer) == list.end()) {
+        list.push_back(referrer);
+    }
+
+    tag_arrays[referrer.tag_id].insert(array_id);
+    if (referrer.role != Role::Reference) {
+        slots[slot(referrer)] = array_id;
+    }
+}
+
+
+void ReferenceIndex::buildTags(const string &group_name, bool multi_tag) const {
+    if (!block.hasGroup(group_name)) {
+        return;
+    }
+
+    block.openGroup(group_name).visitObjects([&](const string &tag_name, H5O_type_t type, const LocID &tag) {
+        if (type != H5O_TYPE_GROUP) {
+            return true;
+        }
+
+        Referrer referrer;
+        referrer.multi_tag = multi_tag;
+        referrer.tag_name = tag_name;
+        tag.getAttr("entity_id", referrer.tag_id);
+
+        Group(tag.h5id(), true).visitObjects([&](const string &name, H5O_type_t sub_type, const LocID &obj) {
+            if (sub_type != H5O_TYPE_GROUP) {
+                return true;
+            }
+
+            string array_id;
+            if (name == "references") {
+                // the links to the referenced data arrays are named by their ids
+                referrer.role = Role::Reference;
+                Group(obj.h5id(), true).visitObjects([&](const string &ref, H5O_type_t, const LocID &) {
+                    insert(ref, referrer);
+                    return true;
+                });
+            } else if (name == "features") {
+                referrer.role = Role::Feature;
+                Group(obj.h5id(), true).visitObjects([&](const string &feature_id, H5O_type_t, const LocID &feature) {
+                    Group feature_group(feature.h5id(), true);
+                    if (feature_group.hasGroup("data")) {
+                        referrer.feature_id = feature_id;
+                        feature_group.openGroup("data", false).getAttr("entity_id", array_id);
+                        insert(array_id, referrer);
+                    }
+                    return true;
+                });
+                referrer.feature_id.clear();
+            } else if (multi_tag && (name == "positions" || name == "extents")) {
+                referrer.role = name == "positions" ? Role::Positions : Role::Extents;
+                obj.getAttr("entity_id", array_id);
+                insert(array_id, referrer);
+            }
+            return true;
+        });
+        return true;
+    });
+}
+
+
+void ReferenceIndex::build() const {
+    referrers.clear();
+    slots.clear();
+    tag_arrays.clear();
+
+    buildTags("tags", false);
+    buildTags("multi_tags", true);
+
+    built = true;
+}
+
+
+const vector<ReferenceIndex::Referrer> &ReferenceIndex::find(const string &array_id) const {
+    static const vector<Referrer> none;
+
+    if (!built) {
+        build();
+    }
+
+    auto it = referrers.find(array_id);
+    return it == referrers.end() ? none : it->second;
+}
+
+
+Group ReferenceIndex::openTag(const Referrer &referrer) const {
+    string path = (referrer.multi_tag ? "multi_tags/" : "tags/") + referrer.tag_name;
+
+    Group group = H5Gopen(block.h5id(), path.c_str(), H5P_DEFAULT);
+    group.check("ReferenceIndex::openTag(): Could not open group: " + path);
+    return group;
+}
+
+
+Group ReferenceIndex::openFeature(const Referrer &referrer) const {
+    string path = (referrer.multi_tag ? "multi_tags/" : "tags/") + referrer.tag_name +
+                  "/features/" + referrer.feature_id;
+
+    Group group = H5Gopen(block.h5id(), path.c_str(), H5P_DEFAULT);
+    group.check("ReferenceIndex::openFeature(): Could not open group: " + path);
+    return group;
+}
+
+
+void ReferenceIndex::add(const string &array_id, const Referrer &referrer) {
+    if (built) {
+        insert(array_id, referrer);
+    }
+}
+
+
+void ReferenceIndex::remove(const string &array_id, const Referrer &referrer) {
+    if (!built) {
+        return;
+    }
+
+    auto it = referrers.find(array_id);
+    if (it != referrers.end()) {
+        vector<Referrer> &list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), referrer), list.end());
+        if (list.empty()) {
+            referrers.erase(it);
+        }
+    }
+
+    if (referrer.role != Role::Reference) {
+        slots.erase(slot(referrer));
+    }
+}
+
+
+void ReferenceIndex::set(const Referrer &referrer, const string &array_id) {
+    if (!built) {
+        return;
+    }
+
+    auto old = slots.find(slot(referrer));
+    if (old != slots.end()) {
+        remove(string(old->second), referrer);
+    }
+
+    if (!array_id.empty()) {
+        insert(array_id, referrer);
+    }
+}
+
+
+void ReferenceIndex::setFeatureData(const string &feature_id, const string &array_id) {
+    if (!built) {
+        return;
+    }
+
+    // a feature is not yet known while it is created
+    auto old = slots.find(feature_id);
+    if (old == slots.end()) {
+        return;
+    }
+
+    for (const Referrer &referrer : referrers.at(old->second)) {
+        if (referrer.role == Role::Feature && referrer.feature_id == feature_id) {
+            set(Referrer(referrer), array_id);
+            return;
+        }
+    }
+}
+
+
+void ReferenceIndex::removeFeature(const string &feature_id) {
+    setFeatureData(feature_id, "");
+}
+
+
+void ReferenceIndex::removeTag(const string &tag_id) {
+    if (!built) {
+        return;
+    }
+
+    auto arrays = tag_arrays.find(tag_id);
+    if (arrays == tag_arrays.end()) {
+        return;
+    }
+
+    for (const string &array_id : arrays->second) {
+        auto it = referrers.find(array_id);
+        if (it == referrers.end()) {
+            continue;
+        }
+
+        vector<Referrer> &list = it->second;
+        for (const Referrer &referrer : list) {
+            if (referrer.tag_id == tag_id && referrer.role != Role::Reference) {
+                slots.erase(slot(referrer));
+            }
+        }
+        list.erase(remove_if(list.begin(), list.end(), [&](const Referrer &referrer) {
+            return referrer.tag_id == tag_id;
+        }), list.end());
+        if (list.empty()) {
+            referrers.erase(it);
+        }
+    }
+
+    tag_arrays.erase(arrays);
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -14,6 +14,7 @@
 #include <nix/Section.hpp>
 
 #include <nix/hdf5/PropertyHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 
 using namespace std;
 using namespace nix::base;
@@ -69,6 +70,12 @@ SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const shared_ptr<ISectio
 // Attribute getter and setter
 //--------------------------------------------------
 
+void SectionHDF5::type(const string &type) {
+    NamedEntityHDF5::type(type);
+    fileHDF5()->sectionIndex().retype(id(), type);
+}
+
+
 void SectionHDF5::repository(const string &repository) {
     group().setAttr("repository", repository);
     forceUpdatedAt();
@@ -97,14 +104,12 @@ void SectionHDF5::link(const std::string &id) {
     if (group().hasGroup("link"))
         link(none);
         
-    File tmp = file();
-    auto found = tmp.findSections(util::IdFilter<Section>(id));
-    if (found.empty())
+    const TreeIndex &index = fileHDF5()->sectionIndex();
+    const TreeIndex::Entry *target = index.find(id);
+    if (!target)
         throw std::runtime_error("SectionHDF5::link: Section not found in file!");
-    
-    auto target = dynamic_pointer_cast<SectionHDF5>(found.front().impl());
 
-    group().createLink(target->group(), "link");
+    group().createLink(index.open(*target), "link");
 }
 
 
@@ -112,12 +117,14 @@ shared_ptr<ISection> SectionHDF5::link() const {
     shared_ptr<ISection> sec;
 
     if (group().hasGroup("link")) {
-        Group other_group = group().openGroup("link", false);
-        auto sec_tmp = make_shared<SectionHDF5>(file(), other_group);
-        // re-get above section "sec_tmp": parent missing, findSections will set it!
-        auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
-        if (found.size() > 0) {
-            sec = found.front().impl();
+        string target_id;
+        group().openGroup("link", false).getAttr("entity_id", target_id);
+
+        // the index provides the linked section together with its parents
+        auto f = fileHDF5();
+        const TreeIndex::Entry *target = f->sectionIndex().find(target_id);
+        if (target) {
+            sec = f->openSection(*target);
         }
     }
 
@@ -162,7 +169,20 @@ void SectionHDF5::mapping(const none_t t) {
 
 
 shared_ptr<ISection> SectionHDF5::parent() const {
-    return parent_section;
+    if (parent_section) {
+        return parent_section;
+    }
+
+    // sections that were not opened through their parent
+    shared_ptr<ISection> parent;
+    auto f = fileHDF5();
+    const TreeIndex &index = f->sectionIndex();
+    const TreeIndex::Entry *entry = index.find(id());
+    if (entry && !entry->parent.empty()) {
+        parent = f->openSection(*index.find(entry->parent));
+    }
+
+    return parent;
 }
 
 
@@ -205,13 +225,57 @@ shared_ptr<ISection> SectionHDF5::getSection(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<ISection>> SectionHDF5::getSections(const util::Match &match) const {
+    vector<shared_ptr<ISection>> entities;
+    boost::optional<Group> g = section_group();
+
+    if (g) {
+        auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<SectionHDF5>(file(), p, group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> SectionHDF5::sectionKeys(const util::Match &match) const {
+    boost::optional<Group> g = section_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
+vector<shared_ptr<ISection>> SectionHDF5::findSections(const util::Match &match, size_t max_depth) const {
+    vector<shared_ptr<ISection>> entities;
+    auto f = fileHDF5();
+    const TreeIndex &index = f->sectionIndex();
+
+    const TreeIndex::Entry *self = index.find(id());
+    if (!self) {
+        return entities;
+    }
+
+    // the found sections keep this section as ancestor, with its parents
+    FileHDF5::SectionMap opened;
+    opened.emplace(self->id, const_pointer_cast<SectionHDF5>(shared_from_this()));
+    for (const TreeIndex::Entry *entry : index.find(match, self, max_depth)) {
+        entities.push_back(f->openSection(*entry, opened));
+    }
+
+    return entities;
+}
+
+
 shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string &type) {
     string new_id = util::createId();
     boost::optional<Group> g = section_group(true);
 
     auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
     Group grp = g->openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    auto section = make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    fileHDF5()->sectionIndex().add(id(), new_id, name, type);
+    return section;
 }
 
 
@@ -230,6 +294,7 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
             }
             // if hasSection is true then section_group always exists
             deleted = g->removeAllLinks(section.name());
+            fileHDF5()->sectionIndex().remove(section.id());
         }
     }
 
@@ -274,6 +339,26 @@ shared_ptr<IProperty> SectionHDF5::getProperty(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<IProperty>> SectionHDF5::getProperties(const util::Match &match) const {
+    vector<shared_ptr<IProperty>> entities;
+    boost::optional<Group> g = property_group();
+
+    if (g) {
+        for (const auto &dset : g->dataSets(match)) {
+            entities.push_back(make_shared<PropertyHDF5>(file(), dset));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> SectionHDF5::propertyKeys(const util::Match &match) const {
+    boost::optional<Group> g = property_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype) {
     string new_id = util::createId();
     boost::optional<Group> g = property_group(true);
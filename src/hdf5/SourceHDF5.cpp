@@ -8,6 +8,7 @@
 
 #include <nix/util/util.hpp>
 #include <nix/hdf5/SourceHDF5.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 #include <nix/Source.hpp>
 
 using namespace std;
@@ -37,6 +38,28 @@ SourceHDF5::SourceHDF5(const shared_ptr<IFile> &file, const Group &group, const
 }
 
 
+TreeIndex *SourceHDF5::sourceIndex() const {
+    // sources are stored below their block, i.e. in "/data/<block>/..."
+    const string path = group().name();
+    const string prefix = "/data/";
+    if (path.compare(0, prefix.size(), prefix) != 0) {
+        return nullptr;
+    }
+
+    size_t end = path.find('/', prefix.size());
+    return fileHDF5()->sourceIndex(path.substr(prefix.size(), end - prefix.size()));
+}
+
+
+void SourceHDF5::type(const string &type) {
+    NamedEntityHDF5::type(type);
+    TreeIndex *index = sourceIndex();
+    if (index) {
+        index->retype(id(), type);
+    }
+}
+
+
 bool SourceHDF5::hasSource(const string &name_or_id) const {
     return getSource(name_or_id) != nullptr;
 }
@@ -63,18 +86,60 @@ shared_ptr<ISource> SourceHDF5::getSource(ndsize_t index) const {
 }
 
 
+vector<shared_ptr<ISource>> SourceHDF5::getSources(const util::Match &match) const {
+    vector<shared_ptr<ISource>> entities;
+    boost::optional<Group> g = source_group();
+
+    if (g) {
+        for (const auto &group : g->groups(match)) {
+            entities.push_back(make_shared<SourceHDF5>(file(), group));
+        }
+    }
+
+    return entities;
+}
+
+
+vector<string> SourceHDF5::sourceKeys(const util::Match &match) const {
+    boost::optional<Group> g = source_group();
+    return g ? g->matchingLinks(match, util::Match::Field::Name) : vector<string>();
+}
+
+
 ndsize_t SourceHDF5::sourceCount() const {
     boost::optional<Group> g = source_group(false);
     return g ? g->objectCount() : size_t(0);
 }
 
 
+vector<shared_ptr<ISource>> SourceHDF5::findSources(const util::Match &match, size_t max_depth) const {
+    vector<shared_ptr<ISource>> entities;
+    const TreeIndex *index = sourceIndex();
+
+    const TreeIndex::Entry *self = index ? index->find(id()) : nullptr;
+    if (!self) {
+        return entities;
+    }
+
+    for (const TreeIndex::Entry *entry : index->find(match, self, max_depth)) {
+        entities.push_back(make_shared<SourceHDF5>(file(), index->open(*entry)));
+    }
+
+    return entities;
+}
+
+
 shared_ptr<ISource> SourceHDF5::createSource(const string &name, const string &type) {
-    string id = util::createId();
+    string new_id = util::createId();
     boost::optional<Group> g = source_group(true);
 
     Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), group, new_id, type, name);
+    TreeIndex *index = sourceIndex();
+    if (index) {
+        index->add(id(), new_id, name, type);
+    }
+    return source;
 }
 
 
@@ -93,6 +158,10 @@ bool SourceHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            TreeIndex *index = sourceIndex();
+            if (index) {
+                index->remove(source.id());
+            }
         }
     }
 
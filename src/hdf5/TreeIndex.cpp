@@ -0,0 +1,256 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/TreeIndex.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+TreeIndex::TreeIndex(const Group &base, const string &children)
+    : base(base), children(children), built(false)
+{}
+
+
+static void erase_pair(unordered_multimap<string, string> &map, const string &key, const string &value) {
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == value) {
+            map.erase(it);
+            return;
+        }
+    }
+}
+
+
+void TreeIndex::insert(Entry &&entry) const {
+    by_name.emplace(entry.name, entry.id);
+    by_type.emplace(entry.type, entry.id);
+
+    if (!entry.parent.empty()) {
+        auto parent = entries.find(entry.parent);
+        if (parent != entries.end()) {
+            parent->second.children.push_back(entry.id);
+        }
+    }
+
+    string id = entry.id;
+    entries[id] = std::move(entry);
+}
+
+
+void TreeIndex::build(const Group &group, const string &name, const string &parent,
+                      const vector<string> &parent_path) const {
+    // only the attributes the index needs, other ones may be of any type
+    Entry entry;
+    group.getAttr("entity_id", entry.id);
+    if (!group.getAttr("name", entry.name)) {
+        entry.name = name;
+    }
+    group.getAttr("type", entry.type);
+    entry.parent = parent;
+    entry.path = parent_path;
+    entry.path.push_back(name);
+
+    // the entry is inserted before its children, so that they are linked to it
+    const string id = entry.id;
+    const vector<string> path = entry.path;
+    insert(std::move(entry));
+
+    group.visitObjects([&](const string &child_name, H5O_type_t type, const LocID &obj) {
+        if (type == H5O_TYPE_GROUP && child_name == children) {
+            Group child_group(obj.h5id(), true);
+            child_group.visitObjects([&](const string &sub_name, H5O_type_t sub_type, const LocID &sub) {
+                if (sub_type == H5O_TYPE_GROUP) {
+                    build(Group(sub.h5id(), true), sub_name, id, path);
+                }
+                return true;
+            });
+            return false;
+        }
+        return true;
+    });
+}
+
+
+void TreeIndex::build() const {
+    entries.clear();
+    by_name.clear();
+    by_type.clear();
+
+    base.visitObjects([this](const string &name, H5O_type_t type, const LocID &obj) {
+        if (type == H5O_TYPE_GROUP) {
+            build(Group(obj.h5id(), true), name, "", vector<string>());
+        }
+        return true;
+    });
+
+    built = true;
+}
+
+
+const TreeIndex::Entry *TreeIndex::find(const string &id) const {
+    if (!built) {
+        build();
+    }
+
+    auto it = entries.find(id);
+    return it == entries.end() ? nullptr : &it->second;
+}
+
+
+vector<const TreeIndex::Entry *> TreeIndex::find(const util::Match &match, const Entry *root, size_t max_depth) const {
+    if (!built) {
+        build();
+    }
+
+    vector<const Entry *> candidates;
+
+    auto add_ids = [&](const unordered_multimap<string, string> &map) {
+        for (const string &value : match.values) {
+            auto range = map.equal_range(value);
+            for (auto it = range.first; it != range.second; ++it) {
+                candidates.push_back(&entries.at(it->second));
+            }
+        }
+    };
+
+    switch (match.field) {
+        case util::Match::Field::Id:
+            for (const string &value : match.values) {
+                auto it = entries.find(value);
+                if (it != entries.end()) {
+                    candidates.push_back(&it->second);
+                }
+            }
+            break;
+        case util::Match::Field::Name:
+            add_ids(by_name);
+            break;
+        case util::Match::Field::Type:
+            add_ids(by_type);
+            break;
+        default:
+            for (const auto &entry : entries) {
+                candidates.push_back(&entry.second);
+            }
+    }
+
+    // keep the entries in the subtree of root, up to max_depth
+    const size_t min_depth = root ? root->depth() : 0;
+    candidates.erase(remove_if(candidates.begin(), candidates.end(), [&](const Entry *entry) {
+        if (entry->depth() < min_depth || entry->depth() - min_depth > max_depth) {
+            return true;
+        }
+        return root && !equal(root->path.begin(), root->path.end(), entry->path.begin());
+    }), candidates.end());
+
+    // the order of a breadth-first search per root, children sorted by name
+    sort(candidates.begin(), candidates.end(), [](const Entry *a, const Entry *b) {
+        if (a->path.front() != b->path.front()) {
+            return a->path.front() < b->path.front();
+        }
+        if (a->path.size() != b->path.size()) {
+            return a->path.size() < b->path.size();
+        }
+        return a->path < b->path;
+    });
+
+    return candidates;
+}
+
+
+Group TreeIndex::open(const Entry &entry) const {
+    string path = entry.path.front();
+    for (size_t i = 1; i < entry.path.size(); i++) {
+        path += "/" + children + "/" + entry.path[i];
+    }
+
+    Group group = H5Gopen(base.h5id(), path.c_str(), H5P_DEFAULT);
+    group.check("TreeIndex::open(): Could not open group: " + path);
+    return group;
+}
+
+
+void TreeIndex::add(const string &parent, const string &id, const string &name, const string &type) {
+    if (!built) {
+        return;
+    }
+
+    Entry entry;
+    entry.id = id;
+    entry.name = name;
+    entry.type = type;
+    entry.parent = parent;
+
+    if (!parent.empty()) {
+        auto it = entries.find(parent);
+        if (it == entries.end()) {
+            // the parent is unknown, the index is out of date
+            built = false;
+            return;
+        }
+        entry.path = it->second.path;
+    }
+    entry.path.push_back(name);
+
+    insert(std::move(entry));
+}
+
+
+void TreeIndex::remove(const string &id) {
+    if (!built) {
+        return;
+    }
+
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+
+    vector<string> children_ids = it->second.children;
+    for (const string &child : children_ids) {
+        remove(child);
+    }
+
+    it = entries.find(id);
+    const Entry &entry = it->second;
+    erase_pair(by_name, entry.name, id);
+    erase_pair(by_type, entry.type, id);
+
+    if (!entry.parent.empty()) {
+        auto parent = entries.find(entry.parent);
+        if (parent != entries.end()) {
+            vector<string> &siblings = parent->second.children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), id), siblings.end());
+        }
+    }
+
+    entries.erase(it);
+}
+
+
+void TreeIndex::retype(const string &id, const string &type) {
+    if (!built) {
+        return;
+    }
+
+    auto it = entries.find(id);
+    if (it != entries.end()) {
+        erase_pair(by_type, it->second.type, id);
+        it->second.type = type;
+        by_type.emplace(type, id);
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
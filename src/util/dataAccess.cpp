@@ -9,6 +9,7 @@
 #include <nix/util/dataAccess.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/DimensionMapper.hpp>
 
 #include <string>
 #include <cstdlib>
@@ -189,6 +190,94 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index
 }
 
 
+void getOffsetsAndCounts(const MultiTag &tag, const DataArray &array, vector<NDSize> &offsets, vector<NDSize> &counts) {
+    DataArray positions = tag.positions();
+    DataArray extents = tag.extents();
+    size_t dimension_count = array.dimensionCount();
+
+    if (!positions) {
+        throw nix::OutOfBounds("Index out of bounds of positions!", 0);
+    }
+
+    NDSize position_size = positions.dataExtent();
+    NDSize extent_size = extents ? extents.dataExtent() : NDSize();
+
+    if (position_size.size() == 1 && dimension_count != 1) {
+        throw nix::IncompatibleDimensions("Number of dimensions in positions does not match dimensionality of data",
+                                          "util::getOffsetsAndCounts");
+    }
+
+    if (position_size.size() > 1 && position_size[1] > dimension_count) {
+        throw nix::IncompatibleDimensions("Number of dimensions in positions does not match dimensionality of data",
+                                          "util::getOffsetsAndCounts");
+    }
+
+    if (extents && extent_size.size() > 1 && extent_size[1] > dimension_count) {
+        throw nix::IncompatibleDimensions("Number of dimensions in extents does not match dimensionality of data",
+                                          "util::getOffsetsAndCounts");
+    }
+
+    const size_t n = check::fits_in_size_t(position_size.size() > 0 ? position_size[0] : 0,
+                                           "util::getOffsetsAndCounts: too many positions");
+
+    if (extents && extent_size[0] < n) {
+        throw nix::OutOfBounds("Index out of bounds of positions or extents!", 0);
+    }
+
+    // read all positions and extents at once, row i holds position i
+    size_t columns = position_size.size() > 1 ? static_cast<size_t>(position_size[1]) : 1;
+    vector<double> position_data(n * columns);
+    if (n > 0) {
+        positions.getData(DataType::Double, position_data.data(), position_size, NDSize(position_size.size(), 0));
+    }
+
+    size_t extent_columns = 0;
+    vector<double> extent_data;
+    if (extents && n > 0) {
+        extent_columns = std::min(extent_size.size() > 1 ? static_cast<size_t>(extent_size[1]) : 1, columns);
+        NDSize count = extent_size;
+        count[0] = n;
+        vector<double> data(count.nelms());
+        extents.getData(DataType::Double, data.data(), count, NDSize(count.size(), 0));
+        size_t stride = extent_size.size() > 1 ? static_cast<size_t>(extent_size[1]) : 1;
+        extent_data.resize(n * extent_columns);
+        for (size_t i = 0; i < n; i++) {
+            std::copy_n(data.begin() + i * stride, extent_columns, extent_data.begin() + i * extent_columns);
+        }
+    }
+
+    offsets.assign(n, NDSize(dimension_count, 0));
+    counts.assign(n, NDSize(dimension_count, 1));
+    vector<string> units = tag.units();
+
+    // convert one dimension at a time
+    vector<double> column(n);
+    for (size_t d = 0; d < columns; d++) {
+        string unit = d < units.size() ? units[d] : "none";
+        DimensionMapper mapper(array.getDimension(d + 1), unit);
+
+        for (size_t i = 0; i < n; i++) {
+            column[i] = position_data[i * columns + d];
+        }
+        vector<size_t> start = mapper.indexOf(column);
+        for (size_t i = 0; i < n; i++) {
+            offsets[i][d] = start[i];
+        }
+
+        if (d < extent_columns) {
+            for (size_t i = 0; i < n; i++) {
+                column[i] += extent_data[i * extent_columns + d];
+            }
+            vector<size_t> end = mapper.indexOf(column);
+            for (size_t i = 0; i < n; i++) {
+                ndsize_t c = end[i] - start[i];
+                counts[i][d] = (c > 1) ? c : 1;
+            }
+        }
+    }
+}
+
+
 bool positionInData(const DataArray &data, const NDSize &position) {
     NDSize data_size = data.dataExtent();
     bool valid = true;
@@ -249,6 +338,47 @@ DataView retrieveData(const MultiTag &tag, size_t position_index, size_t referen
 }
 
 
+DataSegments retrieveDataBatch(const MultiTag &tag, const vector<size_t> &position_indices, size_t reference_index) {
+    if (reference_index >= tag.referenceCount()) {
+        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    }
+
+    DataArray ref = tag.getReference(reference_index);
+    DataType dtype = ref.dataType();
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("util::retrieveDataBatch: string data is not supported");
+    }
+
+    vector<NDSize> all_offsets, all_counts;
+    getOffsetsAndCounts(tag, ref, all_offsets, all_counts);
+
+    DataSegments segments(dtype);
+    segments.offsets.reserve(position_indices.size());
+    segments.counts.reserve(position_indices.size());
+    segments.starts.reserve(position_indices.size() + 1);
+
+    for (size_t index : position_indices) {
+        if (index >= all_offsets.size()) {
+            throw nix::OutOfBounds("Index out of bounds of positions or extents!", 0);
+        }
+
+        const NDSize &offset = all_offsets[index];
+        const NDSize &count = all_counts[index];
+        if (!positionAndExtentInData(ref, offset, count)) {
+            throw nix::OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+        }
+
+        segments.offsets.push_back(offset);
+        segments.counts.push_back(count);
+        segments.starts.push_back(segments.starts.back() + count.nelms());
+    }
+
+    segments.data.resize(NDSize{segments.starts.back()});
+    ref.getDataSegments(dtype, segments.data.data(), segments.offsets, segments.counts);
+    return segments;
+}
+
+
 DataView retrieveData(const Tag &tag, size_t reference_index) {
     vector<double> positions = tag.position();
     vector<double> extents = tag.extent();
@@ -0,0 +1,162 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/units.hpp>
+
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+
+namespace nix {
+namespace util {
+
+// Unit scaling, SI only, substitutions for micro and ohm...
+static const char *PREFIXES[] = {"Y", "Z", "E", "P", "T", "G", "M", "k", "h", "da", "d", "c", "m", "u", "n", "p", "f",
+                                 "a", "z", "y"};
+static const double PREFIX_FACTORS[] = {1.0e24, 1.0e21, 1.0e18, 1.0e15, 1.0e12, 1.0e9, 1.0e6, 1.0e3, 1.0e2, 1.0e1,
+                                        1.0e-1, 1.0e-2, 1.0e-3, 1.0e-6, 1.0e-9, 1.0e-12, 1.0e-15, 1.0e-18, 1.0e-21,
+                                        1.0e-24};
+static const char *UNITS[] = {"m", "g", "s", "A", "K", "mol", "cd", "Hz", "N", "Pa", "J", "W", "C", "V", "F", "S", "Wb",
+                              "T", "H", "lm", "lx", "Bq", "Gy", "Sv", "kat", "l", "L", "Ohm", "%", "dB", "rad"};
+
+// the cache is cleared when it gets larger, files use only a few units
+static const size_t UNIT_CACHE_SIZE = 1024;
+
+
+namespace {
+
+bool matches(const string &str, size_t begin, size_t end, const char *token, size_t &len) {
+    len = strlen(token);
+    return begin + len <= end && str.compare(begin, len, token) == 0;
+}
+
+// "^[+-]?[1-9][0-9]*" or nothing
+bool parsePower(const string &str, size_t begin, size_t end, AtomicUnit &atom) {
+    if (begin == end) {
+        atom.power.clear();
+        atom.exponent = 1;
+        return true;
+    }
+
+    size_t i = begin;
+    if (str[i++] != '^') {
+        return false;
+    }
+    if (i < end && (str[i] == '+' || str[i] == '-')) {
+        i++;
+    }
+    if (i == end || str[i] < '1' || str[i] > '9') {
+        return false;
+    }
+    for (; i < end; i++) {
+        if (str[i] < '0' || str[i] > '9') {
+            return false;
+        }
+    }
+
+    atom.power = str.substr(begin + 1, end - begin - 1);
+    try {
+        atom.exponent = stoi(atom.power);
+    } catch (out_of_range &) {
+        return false;
+    }
+    return true;
+}
+
+
+bool parseBaseUnit(const string &str, size_t begin, size_t end, AtomicUnit &atom) {
+    size_t len;
+    for (const char *unit : UNITS) {
+        if (matches(str, begin, end, unit, len) && parsePower(str, begin + len, end, atom)) {
+            atom.unit = unit;
+            return true;
+        }
+    }
+    return false;
+}
+
+// the prefixes and units are chosen such that a string has at most one
+// valid split, e.g. "mm" is milli-metre and "mol" is mole
+bool parseAtomicUnit(const string &str, size_t begin, size_t end, AtomicUnit &atom) {
+    atom.prefix.clear();
+    atom.factor = 1.0;
+    if (parseBaseUnit(str, begin, end, atom)) {
+        return true;
+    }
+
+    size_t len;
+    for (size_t i = 0; i < sizeof(PREFIXES) / sizeof(PREFIXES[0]); i++) {
+        if (matches(str, begin, end, PREFIXES[i], len) && parseBaseUnit(str, begin + len, end, atom)) {
+            atom.prefix = PREFIXES[i];
+            atom.factor = PREFIX_FACTORS[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+
+Unit parse(const string &name) {
+    Unit parsed;
+    parsed.name = name;
+
+    vector<AtomicUnit> terms;
+    vector<char> separators;
+    size_t begin = 0;
+    for (size_t i = 0; i <= name.size(); i++) {
+        if (i < name.size() && name[i] != '*' && name[i] != '/') {
+            continue;
+        }
+
+        AtomicUnit atom;
+        if (!parseAtomicUnit(name, begin, i, atom)) {
+            return parsed;
+        }
+        terms.push_back(atom);
+
+        if (i < name.size()) {
+            separators.push_back(name[i]);
+        }
+        begin = i + 1;
+    }
+
+    parsed.terms.swap(terms);
+    parsed.separators.swap(separators);
+    return parsed;
+}
+
+} // anonymous namespace
+
+
+shared_ptr<const Unit> parseUnit(const string &unit) {
+    static mutex cache_mutex;
+    static unordered_map<string, shared_ptr<const Unit>> cache;
+
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        auto it = cache.find(unit);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    shared_ptr<const Unit> parsed = make_shared<Unit>(parse(unit));
+
+    lock_guard<mutex> lock(cache_mutex);
+    if (cache.size() >= UNIT_CACHE_SIZE) {
+        cache.clear();
+    }
+    cache.emplace(unit, parsed);
+    return parsed;
+}
+
+} // namespace util
+} // namespace nix
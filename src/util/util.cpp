@@ -9,15 +9,19 @@
 #include <nix/util/util.hpp>
 
 #include <nix/base/IDimensions.hpp>
+#include <nix/util/units.hpp>
 
 #include <string>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include <mutex>
 #include <random>
+#include <limits>
+#include <unordered_map>
 #include <math.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/regex.hpp>
 #include <boost/random.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -31,14 +35,75 @@ namespace util {
 
 // Base32hex alphabet (RFC 4648)
 const char*  ID_ALPHABET = "0123456789abcdefghijklmnopqrstuv";
-// Unit scaling, SI only, substitutions for micro and ohm...
-const string  PREFIXES = "(Y|Z|E|P|T|G|M|k|h|da|d|c|m|u|n|p|f|a|z|y)";
-const string  UNITS = "(m|g|s|A|K|mol|cd|Hz|N|Pa|J|W|C|V|F|S|Wb|T|H|lm|lx|Bq|Gy|Sv|kat|l|L|Ohm|%|dB|rad)";
-const string  POWER = "(\\^[+-]?[1-9]\\d*)";
+// the cache is cleared when it gets larger, files use only a few units
+const size_t  SCALING_CACHE_SIZE = 4096;
 
-const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a", 1.0e-18}, {"f", 1.0e-15},
-    {"p", 1.0e-12}, {"n",1.0e-9}, {"u", 1.0e-6}, {"m", 1.0e-3}, {"c", 1.0e-2}, {"d",1.0e-1}, {"da", 1.0e1}, {"h", 1.0e2},
-    {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
+
+// compound units are only scalable if they are identical
+static bool isScalable(const Unit &unitA, const Unit &unitB) {
+    if (!(unitA.isSI() && unitB.isSI())) {
+        return false;
+    }
+    if (unitA.isAtomic() && unitB.isAtomic()) {
+        return unitA.terms[0].unit == unitB.terms[0].unit && unitA.terms[0].exponent == unitB.terms[0].exponent;
+    }
+    return unitA.isCompound() && unitB.isCompound() && unitA.name == unitB.name;
+}
+
+
+// values per block of the polynomial kernel
+const size_t  POLY_BLOCK = 256;
+
+// GCC on x86-64 Linux also builds an AVX2 version of the kernel; the one
+// matching the CPU is picked when the library is loaded
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define NIX_SIMD_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define NIX_SIMD_CLONES
+#endif
+
+
+// Horner's scheme on blocks of fixed size, so that the compiler vectorizes
+// the inner loops; input and output may be the same
+NIX_SIMD_CLONES
+static void evaluatePolynomial(const double *coefficients, size_t ncoefficients, double origin,
+                               const double *input, double *output, size_t n) {
+    double x[POLY_BLOCK];
+    double value[POLY_BLOCK];
+
+    for (size_t k = 0; k < n; k += POLY_BLOCK) {
+        const size_t m = std::min(POLY_BLOCK, n - k);
+        memcpy(x, input + k, m * sizeof(double));
+        for (size_t j = m; j < POLY_BLOCK; j++) {
+            x[j] = 0.0;
+        }
+
+        for (size_t j = 0; j < POLY_BLOCK; j++) {
+            x[j] -= origin;
+        }
+
+        if (ncoefficients == 0) {
+            // if we have no coefficients, i.e no polynomial specified we
+            // should still apply the the origin transformation
+            memcpy(output + k, x, m * sizeof(double));
+            continue;
+        }
+
+        const double last = coefficients[ncoefficients - 1];
+        for (size_t j = 0; j < POLY_BLOCK; j++) {
+            value[j] = last;
+        }
+
+        for (size_t i = ncoefficients - 1; i-- > 0;) {
+            const double c = coefficients[i];
+            for (size_t j = 0; j < POLY_BLOCK; j++) {
+                value[j] = value[j] * x[j] + c;
+            }
+        }
+
+        memcpy(output + k, value, m * sizeof(double));
+    }
+}
 
 
 string createId() {
@@ -116,36 +181,15 @@ std::string unitSanitizer(const std::string &unit) {
 }
 
 void splitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
-    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
-    boost::regex prefix_and_unit(PREFIXES + UNITS);
-    boost::regex unit_and_power(UNITS + POWER);
-    boost::regex unit_only(UNITS);
-    boost::regex prefix_only(PREFIXES);
-
-    if (boost::regex_match(combinedUnit, prefix_and_unit_and_power)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        string suffix = m.suffix();
-        boost::regex_search(suffix, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, unit_and_power)) {
-        prefix = "";
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, prefix_and_unit)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        unit = m.suffix();
-        power = "";
+    shared_ptr<const Unit> parsed = parseUnit(combinedUnit);
+
+    if (parsed->isAtomic()) {
+        const AtomicUnit &atom = parsed->terms[0];
+        prefix = atom.prefix;
+        unit = atom.unit;
+        power = atom.power;
     } else {
-        unit = combinedUnit;
+        unit = parsed->name;
         prefix = "";
         power = "";
     }
@@ -168,49 +212,40 @@ void invertPower(std::string &unit) {
 
 
 void splitCompoundUnit(const std::string &compoundUnit, std::vector<std::string> &atomicUnits) {
-    string s = compoundUnit;
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    boost::regex separator("(\\*|/)");
-    boost::match_results<std::string::const_iterator> m;
-    string sep;
-    while (boost::regex_search(s, m, opt_prefix_and_unit_and_power) && (m.suffix().length() > 0)) {
-        string suffix = m.suffix();
-        util::deblankString(suffix);
-        if (sep == "/") {
-            string unit = m[0];
+    const string s = deblankString(compoundUnit);
+    char sep = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i <= s.size(); i++) {
+        if (i < s.size() && s[i] != '*' && s[i] != '/') {
+            continue;
+        }
+
+        string unit = s.substr(begin, i - begin);
+        if (sep == '/') {
             invertPower(unit);
-            atomicUnits.push_back(unit);
-        } else {
-            atomicUnits.push_back(m[0]);
         }
-        sep = suffix[0];
-        s = suffix.substr(1);
-    }
-    if (sep == "/") {
-        string unit = m[0];
-        invertPower(unit);
         atomicUnits.push_back(unit);
-    } else {
-        atomicUnits.push_back(m[0]);
+
+        if (i < s.size()) {
+            sep = s[i];
+        }
+        begin = i + 1;
     }
 }
 
 
 bool isSIUnit(const string &unit) {
-    return !unit.empty() && (isAtomicSIUnit(unit) || isCompoundSIUnit(unit));
+    return parseUnit(unit)->isSI();
 }
 
 
 bool isAtomicSIUnit(const string &unit) {
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    return boost::regex_match(unit, opt_prefix_and_unit_and_power);
+    return parseUnit(unit)->isAtomic();
 }
 
 
 bool isCompoundSIUnit(const string &unit) {
-    string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
-    boost::regex compound_unit("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
-    return !unit.empty() && boost::regex_match(unit, compound_unit);
+    return parseUnit(unit)->isCompound();
 }
 
 
@@ -222,17 +257,7 @@ std::string dimTypeToStr(const nix::DimensionType &dtype) {
 
 
 bool isScalable(const string &unitA, const string &unitB) {
-    if (!(isSIUnit(unitA) && isSIUnit(unitB))) {
-        return false;
-    }
-    string a_unit, a_prefix, a_power;
-    string b_unit, b_prefix, b_power;
-    splitUnit(unitA, a_prefix, a_unit, a_power);
-    splitUnit(unitB, b_prefix, b_unit, b_power);
-    if (!(a_unit == b_unit) || !(a_power == b_power) ) {
-        return false;
-    }
-    return true;
+    return isScalable(*parseUnit(unitA), *parseUnit(unitB));
 }
 
 
@@ -275,30 +300,50 @@ bool isSetAtSamePos(const vector<string> &unitsA, const vector<string> &unitsB)
 
 
 double getSIScaling(const string &originUnit, const string &destinationUnit) {
-    double scaling = 1.0;
-    if (!isScalable(originUnit, destinationUnit)) {
-        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
-                               "nix::util::getSIScaling");
+    static mutex cache_mutex;
+    static unordered_map<string, double> cache;
+
+    // unit strings do not contain '\0'
+    string key = originUnit;
+    key += '\0';
+    key += destinationUnit;
+
+    double scaling;
+    bool cached;
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        auto it = cache.find(key);
+        cached = it != cache.end();
+        scaling = cached ? it->second : 0.0;
     }
-    
-    string org_unit, org_prefix, org_power;
-    string dest_unit, dest_prefix, dest_power;
-    splitUnit(originUnit, org_prefix, org_unit, org_power);
-    splitUnit(destinationUnit, dest_prefix, dest_unit, dest_power);
 
-    if ((org_prefix == dest_prefix) && (org_power == dest_power)) {
-        return scaling;
-    }
-    if (dest_prefix.empty() && !org_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix);
-    } else if (org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = 1.0 / PREFIX_FACTORS.at(dest_prefix);
-    } else if (!org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix) / PREFIX_FACTORS.at(dest_prefix);
+    if (!cached) {
+        shared_ptr<const Unit> origin = parseUnit(originUnit);
+        shared_ptr<const Unit> destination = parseUnit(destinationUnit);
+
+        // NaN marks units that are not scalable
+        scaling = numeric_limits<double>::quiet_NaN();
+        if (isScalable(*origin, *destination)) {
+            scaling = 1.0;
+            if (origin->isAtomic()) {
+                const AtomicUnit &org = origin->terms[0];
+                const AtomicUnit &dest = destination->terms[0];
+                if (org.prefix != dest.prefix) {
+                    scaling = pow(org.factor / dest.factor, org.exponent);
+                }
+            }
+        }
+
+        lock_guard<mutex> lock(cache_mutex);
+        if (cache.size() >= SCALING_CACHE_SIZE) {
+            cache.clear();
+        }
+        cache.emplace(key, scaling);
     }
-    if (!org_power.empty()) {
-        int power = std::stoi(org_power);
-        scaling = pow(scaling, power);
+
+    if (std::isnan(scaling)) {
+        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
+                               "nix::util::getSIScaling");
     }
     return scaling;
 }
@@ -308,27 +353,7 @@ void applyPolynomial(const std::vector<double> &coefficients,
                      const double *input,
                      double *output,
                      size_t n) {
-
-    if (!coefficients.size()) {
-        // if we have no coefficients, i.e no polynomial specified we
-        // should still apply the the origin transformation
-        for (size_t k = 0; k < n; k++) {
-            output[k] = input[k] - origin;
-        }
-
-    } else {
-
-        for (size_t k = 0; k < n; k++) {
-            const double x = input[k] - origin;
-            double value = 0.0;
-            double term = 1.0;
-            for (size_t i = 0; i < coefficients.size(); i++) {
-                value += coefficients[i] * term;
-                term *= x;
-            }
-            output[k] = value;
-        }
-    }
+    evaluatePolynomial(coefficients.data(), coefficients.size(), origin, input, output, n);
 }
 
 bool looksLikeUUID(const std::string &id) {
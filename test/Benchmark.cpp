@@ -120,8 +120,10 @@ private:
 class Config {
 
 public:
-    Config(nix::DataType data_type, const nix::NDSize &blocksize)
-            : data_type(data_type), block_size(blocksize) {
+    Config(nix::DataType data_type, const nix::NDSize &blocksize,
+           const nix::Compression &compression = nix::Compression(),
+           const nix::Chunking &chunking = nix::Chunking())
+            : data_type(data_type), block_size(blocksize), filters(compression), chunk_hints(chunking) {
 
         sdim = find_single_dim();
         shape = blocksize;
@@ -149,6 +151,8 @@ public:
     nix::DataType dtype() const { return data_type; }
     const nix::NDSize& size() const { return block_size; }
     const nix::NDSize& extend() const { return shape; }
+    const nix::Compression& compression() const { return filters; }
+    const nix::Chunking& chunking() const { return chunk_hints; }
     size_t singleton_dimension() const { return sdim; }
     const std::string & name() const { return my_name; };
 
@@ -163,12 +167,22 @@ private:
         }
         s << "}";
 
+        if (filters.enabled()) {
+            s << "+z" << filters.deflate << (filters.shuffle ? "s" : "");
+        }
+
+        if (chunk_hints.hasHints()) {
+            s << "+c";
+        }
+
         my_name = s.str();
     }
 
 private:
     const nix::DataType data_type;
     const nix::NDSize block_size;
+    const nix::Compression filters;
+    const nix::Chunking chunk_hints;
 
     size_t        sdim;
     nix::NDSize   shape;
@@ -257,11 +271,20 @@ public:
     nix::DataArray openDataArray(nix::Block block) const {
         const std::string &cfg_name = config.name();
         std::vector<nix::DataArray> v = block.dataArrays(nix::util::NameFilter<nix::DataArray>(cfg_name));
+        nix::DataArray da;
         if (v.empty()) {
-            return block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend());
+            da = block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend(),
+                                       config.compression(), config.chunking());
         } else {
-            return v[0];
+            da = v[0];
         }
+
+        // narrow chunks need a cache that holds all chunks a block touches
+        if (config.chunking().hasHints()) {
+            da.chunkCacheFor(config.size());
+        }
+
+        return da;
     }
 
     virtual ~Benchmark() { }
@@ -355,6 +378,101 @@ public:
 };
 
 
+class AppendBenchmark : public Benchmark {
+
+public:
+    AppendBenchmark(const Config &cfg)
+            : Benchmark(cfg) {
+    };
+
+    void run(nix::Block block) override {
+        nix::DataArray da = block.createDataArray(config.name() + "+a", "nix.test.da",
+                                                  config.dtype(), config.extend());
+
+        BlockGenerator generator(config, 10);
+
+        size_t N = 100;
+        size_t iterations = 0;
+
+        Stopwatch sw;
+        ssize_t ms = 0;
+        {
+            nix::DataAppender app = da.appender(config.singleton_dimension());
+            do {
+                Stopwatch inner;
+
+                for (size_t i = 0; i < N; i++) {
+                    nix::NDArray block = generator.next_block();
+                    app.append(config.dtype(), block.data(), config.size());
+                    iterations++;
+                }
+
+                if (inner.ms() < 100) {
+                    N *= 2;
+                }
+
+            } while (sw.ms() < 3*1000);
+        }
+        ms = sw.ms();
+
+        this->count = iterations;
+        this->millis = ms;
+    }
+
+    std::string id() override {
+        return "A";
+    }
+};
+
+
+class AsyncWriteBenchmark : public Benchmark {
+
+public:
+    AsyncWriteBenchmark(const Config &cfg)
+            : Benchmark(cfg) {
+    };
+
+    void run(nix::Block block) override {
+        nix::DataArray da = block.createDataArray(config.name() + "+q", "nix.test.da",
+                                                  config.dtype(), config.extend());
+
+        BlockGenerator generator(config, 10);
+
+        size_t N = 100;
+        size_t iterations = 0;
+
+        Stopwatch sw;
+        ssize_t ms = 0;
+        {
+            nix::AsyncAppender app(da, config.singleton_dimension());
+            do {
+                Stopwatch inner;
+
+                for (size_t i = 0; i < N; i++) {
+                    nix::NDArray block = generator.next_block();
+                    app.append(config.dtype(), block.data(), config.size());
+                    iterations++;
+                }
+
+                if (inner.ms() < 100) {
+                    N *= 2;
+                }
+
+            } while (sw.ms() < 3*1000);
+            app.close();
+        }
+        ms = sw.ms();
+
+        this->count = iterations;
+        this->millis = ms;
+    }
+
+    std::string id() override {
+        return "Q";
+    }
+};
+
+
 class ReadBenchmark : public Benchmark {
 
 public:
@@ -392,6 +510,45 @@ public:
 };
 
 
+class ChannelReadBenchmark : public Benchmark {
+
+public:
+    ChannelReadBenchmark(const Config &cfg)
+            : Benchmark(cfg) {
+    };
+
+    // reads the data channel by channel, i.e. along the singleton
+    // dimension for every position of the other one
+    void run(nix::Block block) override {
+        nix::DataArray da = openDataArray(block);
+
+        const size_t sdim = config.singleton_dimension();
+        const size_t cdim = 1 - sdim;
+
+        nix::NDSize extend = da.dataExtent();
+        nix::NDSize count = extend;
+        count[cdim] = 1;
+
+        nix::NDArray array(config.dtype(), count);
+        nix::NDSize pos = {0, 0};
+
+        ssize_t ms = time_it([this, &da, &count, &pos, &array, &extend, cdim] {
+            for (size_t i = 0; i < extend[cdim]; i++) {
+                pos[cdim] = i;
+                da.getData(config.dtype(), array.data(), count, pos);
+            }
+        });
+
+        this->count = extend[sdim];
+        this->millis = ms;
+    }
+
+    std::string id() override {
+        return "C";
+    }
+};
+
+
 class ReadPolyBenchmark : public ReadBenchmark {
 
 public:
@@ -543,6 +700,32 @@ static std::vector<Config> make_configs() {
     return configs;
 }
 
+static std::vector<Config> make_filter_configs() {
+
+    std::vector<Config> configs;
+
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{2048, 1});
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{2048, 1}, nix::Compression::deflateWith(1, true));
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{2048, 1}, nix::Compression::deflateWith(6, true));
+
+    return configs;
+}
+
+// time x channel data, appended one sample of all channels at a time and
+// read channel by channel; guessed chunks vs. chunks chosen from the hints
+static std::vector<Config> make_chunking_configs() {
+
+    std::vector<Config> configs;
+
+    nix::Chunking chunking = nix::Chunking::growingAlong(0);
+    chunking.read_axis = 0;
+
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 64});
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 64}, nix::Compression(), chunking);
+
+    return configs;
+}
+
 int main(int argc, char **argv)
 {
     nix::File fd = nix::File::open("iospeed.h5", nix::FileMode::Overwrite);
@@ -579,6 +762,20 @@ int main(int argc, char **argv)
         marks.push_back(benchmark);
     }
 
+    std::cout << "Performing append tests..." << std::endl;
+    for (const Config &cfg : configs) {
+        AppendBenchmark *benchmark = new AppendBenchmark(cfg);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
+    std::cout << "Performing async write tests..." << std::endl;
+    for (const Config &cfg : configs) {
+        AsyncWriteBenchmark *benchmark = new AsyncWriteBenchmark(cfg);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
     std::cout << "Performing read tests..." << std::endl;
     for (const Config &cfg : configs) {
         ReadBenchmark *benchmark = new ReadBenchmark(cfg);
@@ -593,6 +790,28 @@ int main(int argc, char **argv)
         marks.push_back(benchmark);
     }
 
+    std::cout << "Performing filter write/read tests..." << std::endl;
+    for (const Config &cfg : make_filter_configs()) {
+        WriteBenchmark *wb = new WriteBenchmark(cfg);
+        wb->run(block);
+        marks.push_back(wb);
+
+        ReadBenchmark *rb = new ReadBenchmark(cfg);
+        rb->run(block);
+        marks.push_back(rb);
+    }
+
+    std::cout << "Performing chunking tests..." << std::endl;
+    for (const Config &cfg : make_chunking_configs()) {
+        WriteBenchmark *wb = new WriteBenchmark(cfg);
+        wb->run(block);
+        marks.push_back(wb);
+
+        ChannelReadBenchmark *cb = new ChannelReadBenchmark(cfg);
+        cb->run(block);
+        marks.push_back(cb);
+    }
+
     std::cout << " === Reports ===" << std::endl;
     std::cout.precision(5);
     std::cout.unsetf (std::ios::floatfield);
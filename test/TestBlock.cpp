@@ -14,6 +14,7 @@
 #include <nix/Exception.hpp>
 
 #include <ctime>
+#include <type_traits>
 
 using namespace std;
 using namespace nix;
@@ -174,6 +175,15 @@ void TestBlock::testDataArrayAccess() {
         CPPUNIT_ASSERT(name && *name == "data_array_c");
     }
 
+    filteredArrays = block.dataArrays(util::IdFilter<DataArray>(ids[1]));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), filteredArrays.size());
+    CPPUNIT_ASSERT_EQUAL(ids[1], filteredArrays[0].id());
+
+    filteredArrays = block.dataArrays(util::IdsFilter<DataArray>({ids[0], ids[2], "missing"}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), filteredArrays.size());
+
+    CPPUNIT_ASSERT(block.dataArrays(util::NameFilter<DataArray>("missing")).empty());
+
     for (auto it = ids.begin(); it != ids.end(); it++) {
         DataArray data_array = block.getDataArray(*it);
         CPPUNIT_ASSERT(block.hasDataArray(*it) == true);
@@ -292,6 +302,61 @@ void TestBlock::testMultiTagAccess() {
 }
 
 
+void TestBlock::testEntityRange() {
+    for (int i = 0; i < 10; i++) {
+        block.createDataArray("range_" + nix::util::numToStr(i), i % 2 ? "odd" : "even",
+                              DataType::Double, nix::NDSize({1}));
+    }
+
+    EntityRange<DataArray> range = block.dataArrayRange();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), range.size());
+    CPPUNIT_ASSERT(!range.empty());
+
+    vector<DataArray> all = block.dataArrays();
+    vector<DataArray> listed = range.toVector();
+    CPPUNIT_ASSERT_EQUAL(all.size(), listed.size());
+    for (size_t i = 0; i < all.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(all[i].id(), listed[i].id());
+    }
+
+    size_t visited = 0;
+    for (const DataArray &da : range) {
+        CPPUNIT_ASSERT(da);
+        if (++visited == 3) {
+            break;
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), visited);
+
+    // the type is only checked while iterating
+    range = block.dataArrayRange(util::TypeFilter<DataArray>("odd"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), range.size());
+    range.prefetch(4);
+    visited = 0;
+    for (auto it = range.begin(); it != range.end(); ++it) {
+        CPPUNIT_ASSERT_EQUAL(string("odd"), it->type());
+        visited++;
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), visited);
+
+    typedef std::iterator_traits<EntityRange<DataArray>::iterator> traits;
+    CPPUNIT_ASSERT((std::is_same<traits::reference, const DataArray&>::value));
+    CPPUNIT_ASSERT((std::is_same<traits::iterator_category, std::forward_iterator_tag>::value));
+
+    range = block.dataArrayRange(util::NameFilter<DataArray>("range_7"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), range.size());
+    CPPUNIT_ASSERT_EQUAL(string("range_7"), range.begin()->name());
+
+    // entities deleted after the range was created are skipped
+    range = block.dataArrayRange();
+    block.deleteDataArray("range_0");
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(9), range.toVector().size());
+
+    CPPUNIT_ASSERT(block.tagRange().empty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), file.blockRange().size());
+    CPPUNIT_ASSERT_EQUAL(section.id(), file.sectionRange().begin()->id());
+}
+
 void TestBlock::testOperators() {
     CPPUNIT_ASSERT(block_null == false);
     CPPUNIT_ASSERT(block_null == none);
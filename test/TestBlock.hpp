@@ -43,6 +43,7 @@ private:
     CPPUNIT_TEST(testDataArrayAccess);
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
+    CPPUNIT_TEST(testEntityRange);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -73,6 +74,7 @@ public:
     void testDataArrayAccess();
     void testTagAccess();
     void testMultiTagAccess();
+    void testEntityRange();
 
     void testOperators();
     void testUpdatedAt();
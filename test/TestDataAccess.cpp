@@ -9,6 +9,7 @@
 #include "TestDataAccess.hpp"
 
 #include <nix/DataView.hpp>
+#include <nix/SegmentReducer.hpp>
 
 using namespace std;
 using namespace nix;
@@ -219,6 +220,188 @@ void TestDataAccess::testOffsetAndCount() {
 }
 
 
+void TestDataAccess::testOffsetsAndCounts() {
+    vector<NDSize> offsets, counts;
+    util::getOffsetsAndCounts(multi_tag, data_array, offsets, counts);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), offsets.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), counts.size());
+
+    for (size_t i = 0; i < offsets.size(); i++) {
+        NDSize offset, count;
+        util::getOffsetAndCount(multi_tag, data_array, i, offset, count);
+        CPPUNIT_ASSERT_EQUAL(offset, offsets[i]);
+        CPPUNIT_ASSERT_EQUAL(count, counts[i]);
+    }
+
+    MultiTag unit_tag = block.createMultiTag("bulk", "testTag", multi_tag.positions());
+    unit_tag.extents(multi_tag.extents());
+    unit_tag.units(vector<string>{"none", "ms", "s"});
+    unit_tag.addReference(data_array);
+
+    unit_tag.retrieveOffsets(0, offsets, counts);
+    for (size_t i = 0; i < offsets.size(); i++) {
+        NDSize offset, count;
+        util::getOffsetAndCount(unit_tag, data_array, i, offset, count);
+        CPPUNIT_ASSERT_EQUAL(offset, offsets[i]);
+        CPPUNIT_ASSERT_EQUAL(count, counts[i]);
+    }
+
+    CPPUNIT_ASSERT_THROW(unit_tag.retrieveOffsets(1, offsets, counts), nix::OutOfBounds);
+    unit_tag.units(vector<string>{"mV", "Ohm", "muV"});
+    CPPUNIT_ASSERT_THROW(unit_tag.retrieveOffsets(0, offsets, counts), nix::IncompatibleDimensions);
+}
+
+
+void TestDataAccess::testRetrieveDataBatch() {
+    // 2-d data; slices 0 and 1 interleave in file order, 2 overlaps 0
+    DataArray grid = block.createDataArray("grid", "test", DataType::Int32, NDSize({10, 20}));
+    vector<int> values(200);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i);
+    }
+    grid.setData(DataType::Int32, values.data(), NDSize({10, 20}), NDSize({0, 0}));
+    grid.appendSetDimension();
+    grid.appendSetDimension();
+
+    typedef boost::multi_array<double, 2> position_type;
+    position_type pos(boost::extents[4][2]);
+    position_type ext(boost::extents[4][2]);
+    double p[4][2] = {{1, 2}, {1, 10}, {2, 3}, {6, 0}};
+    double e[4][2] = {{3, 4}, {3, 5}, {1, 1}, {4, 20}};
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            pos[i][j] = p[i][j];
+            ext[i][j] = e[i][j];
+        }
+    }
+
+    DataArray grid_pos = block.createDataArray("grid positions", "test", DataType::Double, NDSize({4, 2}));
+    grid_pos.setData(pos);
+    DataArray grid_ext = block.createDataArray("grid extents", "test", DataType::Double, NDSize({4, 2}));
+    grid_ext.setData(ext);
+
+    MultiTag grid_tag = block.createMultiTag("grid tag", "test", grid_pos);
+    grid_tag.extents(grid_ext);
+    grid_tag.addReference(grid);
+
+    vector<size_t> indices = {3, 0, 1, 2, 0};
+    DataSegments segs = grid_tag.retrieveDataBatch(indices, 0);
+    CPPUNIT_ASSERT_EQUAL(indices.size(), segs.size());
+    CPPUNIT_ASSERT_EQUAL(segs.starts.back(), segs.data.size().nelms());
+
+    for (size_t i = 0; i < indices.size(); i++) {
+        DataView view = grid_tag.retrieveData(indices[i], 0);
+        CPPUNIT_ASSERT_EQUAL(view.dataExtent(), segs.counts[i]);
+        CPPUNIT_ASSERT_EQUAL(view.dataExtent().nelms(), segs.starts[i + 1] - segs.starts[i]);
+
+        vector<int> expected(view.dataExtent().nelms());
+        view.getData(DataType::Int32, expected.data(), view.dataExtent(), NDSize(2, 0));
+        const int *slice = segs.segment<int>(i);
+        for (size_t k = 0; k < expected.size(); k++) {
+            CPPUNIT_ASSERT_EQUAL(expected[k], slice[k]);
+        }
+    }
+
+    // polynomial applied, read back as double
+    grid.polynomCoefficients(vector<double>{1.0, 0.5});
+    segs = grid_tag.retrieveDataBatch(vector<size_t>{1, 2}, 0);
+    CPPUNIT_ASSERT_EQUAL(DataType::Int32, segs.data.dtype());
+    DataView view = grid_tag.retrieveData(2, 0);
+    vector<double> expected(view.dataExtent().nelms());
+    view.getData(DataType::Double, expected.data(), view.dataExtent(), NDSize(2, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected[0]), segs.segment<int>(1)[0]);
+
+    CPPUNIT_ASSERT(grid_tag.retrieveDataBatch(vector<size_t>(), 0).size() == 0);
+    CPPUNIT_ASSERT_THROW(grid_tag.retrieveDataBatch(vector<size_t>{4}, 0), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(grid_tag.retrieveDataBatch(vector<size_t>{0}, 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(multi_tag.retrieveDataBatch(vector<size_t>{0, 1}, 0), nix::OutOfBounds);
+}
+
+
+void TestDataAccess::testSegmentReducer() {
+    const size_t n = 1000, nev = 50, width = 10;
+    DataArray trace = block.createDataArray("trace", "test", DataType::Double, NDSize({n}));
+    vector<double> samples(n);
+    for (size_t i = 0; i < n; i++) {
+        samples[i] = static_cast<double>(i % 7);
+    }
+    trace.setData(samples);
+    trace.appendSampledDimension(1.0);
+
+    vector<double> onsets(nev), widths(nev, static_cast<double>(width));
+    for (size_t i = 0; i < nev; i++) {
+        onsets[i] = static_cast<double>(i * 19);
+    }
+    DataArray onset_array = block.createDataArray("onsets", "test", DataType::Double, NDSize({nev}));
+    onset_array.setData(onsets);
+    DataArray width_array = block.createDataArray("widths", "test", DataType::Double, NDSize({nev}));
+    width_array.setData(widths);
+
+    MultiTag events = block.createMultiTag("events", "test", onset_array);
+    events.extents(width_array);
+    events.addReference(trace);
+
+    // small batches, so that all workers get some
+    SegmentReducer reducer(events, 0, 3, 8 * width * sizeof(double));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), reducer.workers());
+
+    SegmentReducer::Stats stats = reducer.stats();
+    CPPUNIT_ASSERT_EQUAL(nev, stats.count);
+    CPPUNIT_ASSERT_EQUAL(NDSize({width}), stats.shape);
+
+    for (size_t k = 0; k < width; k++) {
+        double sum = 0.0, sq = 0.0, lo = 7.0, hi = -1.0;
+        for (size_t e = 0; e < nev; e++) {
+            double x = samples[e * 19 + k];
+            sum += x;
+            sq += x * x;
+            lo = min(lo, x);
+            hi = max(hi, x);
+        }
+        double mean = sum / nev;
+        double var = (sq - nev * mean * mean) / (nev - 1);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, stats.sum[k], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, stats.mean[k], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(var, stats.variance[k], 1e-9);
+        CPPUNIT_ASSERT_EQUAL(lo, stats.min[k]);
+        CPPUNIT_ASSERT_EQUAL(hi, stats.max[k]);
+    }
+
+    // custom reducer: histogram of the values
+    vector<size_t> subset = {0, 2, 4, 4};
+    vector<size_t> hist = reducer.reduce<vector<size_t>>(subset, vector<size_t>(7, 0),
+        [](vector<size_t> &h, const double *data, const NDSize &count) {
+            for (ndsize_t i = 0; i < count.nelms(); i++) {
+                h[static_cast<size_t>(data[i])]++;
+            }
+        },
+        [](vector<size_t> &h, const vector<size_t> &other) {
+            for (size_t i = 0; i < h.size(); i++) {
+                h[i] += other[i];
+            }
+        });
+
+    vector<size_t> expected(7, 0);
+    for (size_t e : subset) {
+        for (size_t k = 0; k < width; k++) {
+            expected[static_cast<size_t>(samples[e * 19 + k])]++;
+        }
+    }
+    CPPUNIT_ASSERT(hist == expected);
+
+    CPPUNIT_ASSERT_THROW(reducer.stream(vector<size_t>{0, 1, 2},
+                                        [](size_t, const double *, const NDSize &) {
+                                            throw std::runtime_error("reducer failed");
+                                        }), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(reducer.stats(vector<size_t>{nev}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(SegmentReducer(events, 1), nix::OutOfBounds);
+
+    widths[1] = 5.0;
+    width_array.setData(widths);
+    CPPUNIT_ASSERT_THROW(reducer.stats(), nix::IncompatibleDimensions);
+}
+
+
 void TestDataAccess::testPositionInData() {
     NDSize offsets, counts;
     util::getOffsetAndCount(multi_tag, data_array, 0, offsets, counts);
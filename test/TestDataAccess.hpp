@@ -33,8 +33,11 @@ private:
     CPPUNIT_TEST(testPositionToIndexSetDimension);
     CPPUNIT_TEST(testPositionToIndexRangeDimension);
     CPPUNIT_TEST(testOffsetAndCount);
+    CPPUNIT_TEST(testOffsetsAndCounts);
     CPPUNIT_TEST(testPositionInData);
     CPPUNIT_TEST(testRetrieveData);
+    CPPUNIT_TEST(testRetrieveDataBatch);
+    CPPUNIT_TEST(testSegmentReducer);
     CPPUNIT_TEST(testTagFeatureData);
     CPPUNIT_TEST(testMultiTagFeatureData);
     CPPUNIT_TEST(testMultiTagUnitSupport);
@@ -57,8 +60,11 @@ public:
     void testPositionToIndexSampledDimension();
     void testPositionToIndexRangeDimension();
     void testOffsetAndCount();
+    void testOffsetsAndCounts();
     void testPositionInData();
     void testRetrieveData();
+    void testRetrieveDataBatch();
+    void testSegmentReducer();
     void testTagFeatureData();
     void testMultiTagFeatureData();
     void testMultiTagUnitSupport();
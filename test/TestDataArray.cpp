@@ -12,8 +12,11 @@
 
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
+#include <nix/hdf5/EntityHDF5.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <cmath>
 
 using namespace nix;
 using namespace valid;
@@ -272,6 +275,47 @@ void TestDataArray::testData()
         CPPUNIT_ASSERT_EQUAL(i > 3*4*5-1 ? 2.0 : 1.0, append_check[i]);
     }
 
+    DataArray daB = block.getDataArray(daA.id());
+    CPPUNIT_ASSERT_EQUAL(NDSize({6, 4, 5}), daB.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(DataType::Double, daB.dataType());
+}
+
+void TestDataArray::testDataExtentHandles()
+{
+    std::vector<double> values(10, 1.0);
+    DataArray a = block.createDataArray("extent", "test", values);
+    DataArray a2 = block.getDataArray(a.id());
+    CPPUNIT_ASSERT_EQUAL(NDSize({10}), a2.dataExtent());
+
+    // resized through another handle
+    a.appendData(DataType::Double, values.data(), {10}, 0);
+    CPPUNIT_ASSERT_EQUAL(NDSize({20}), a2.dataExtent());
+
+    std::vector<double> tail(5, 0.0);
+    a2.getData(DataType::Double, tail.data(), {5}, {12});
+    CPPUNIT_ASSERT(tail == std::vector<double>(5, 1.0));
+
+    // segments are laid out by the current extent
+    DataArray b = block.createDataArray("extent_2d", "test", DataType::Double, NDSize({2, 3}));
+    DataArray b2 = block.getDataArray(b.id());
+    CPPUNIT_ASSERT_EQUAL(NDSize({2, 3}), b2.dataExtent());
+    b.dataExtent({2, 6});
+    std::vector<double> grid;
+    for (size_t i = 0; i < 12; i++) {
+        grid.push_back(10.0 * (i / 6) + i % 6);
+    }
+    b.setData(DataType::Double, grid.data(), {2, 6}, {0, 0});
+
+    std::vector<double> segs(6, 0.0);
+    b2.getDataSegments(DataType::Double, segs.data(), {{0, 4}, {1, 0}}, {{2, 2}, {1, 2}});
+    CPPUNIT_ASSERT(segs == std::vector<double>({4, 5, 14, 15, 10, 11}));
+
+    // resized through the ticks of an alias range dimension
+    DataArray t = block.createDataArray("extent_ticks", "test", std::vector<double>{1, 2, 3, 4, 5});
+    RangeDimension rd = t.appendAliasRangeDimension();
+    CPPUNIT_ASSERT_EQUAL(NDSize({5}), t.dataExtent());
+    rd.ticks({1, 2, 3, 4, 5, 6, 7, 8});
+    CPPUNIT_ASSERT_EQUAL(NDSize({8}), t.dataExtent());
 }
 
 void TestDataArray::testPolynomial()
@@ -358,6 +402,47 @@ void TestDataArray::testPolynomial()
     }
 }
 
+void TestDataArray::testPolynomialConversion()
+{
+    // more values than one block of the calibration
+    std::vector<int16_t> raw(3000);
+    for (size_t i = 0; i < raw.size(); i++) {
+        raw[i] = static_cast<int16_t>(static_cast<int>(i) - 1500);
+    }
+
+    nix::DataArray da = block.createDataArray("polyconv", "int16", raw);
+    da.polynomCoefficients({0.5, 0.25});
+    da.expansionOrigin(100.0);
+
+    std::vector<double> dv;
+    da.getData(dv);
+    std::vector<float> fv;
+    da.getData(fv);
+    std::vector<int32_t> iv;
+    da.getData(iv);
+    std::vector<int8_t> sv;
+    da.getData(sv);
+    std::vector<uint16_t> uv;
+    da.getData(uv);
+
+    for (size_t i = 0; i < raw.size(); i++) {
+        const double expected = 0.5 + 0.25 * (raw[i] - 100.0);
+        CPPUNIT_ASSERT_EQUAL(expected, dv[i]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<float>(expected), fv[i]);
+        // truncated towards zero and saturated
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32_t>(expected), iv[i]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int8_t>(std::max(-128.0, std::min(127.0, std::trunc(expected)))), sv[i]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16_t>(std::max(0.0, std::trunc(expected))), uv[i]);
+    }
+
+    // stored values wider than the requested ones
+    nix::DataArray wide = block.createDataArray("polyconv_wide", "double", std::vector<double>{-1.5, 2.5, 1e10});
+    wide.polynomCoefficients({0.0, 2.0});
+    std::vector<int32_t> wv;
+    wide.getData(wv);
+    CPPUNIT_ASSERT(wv == std::vector<int32_t>({-3, 5, std::numeric_limits<int32_t>::max()}));
+}
+
 void TestDataArray::testLabel()
 {
     std::string testStr = "somestring";
@@ -380,6 +465,341 @@ void TestDataArray::testUnit()
     CPPUNIT_ASSERT(array1.unit() == nix::none);
 }
 
+void TestDataArray::testAttributeCache()
+{
+    file.attributeCache(true);
+    nix::DataArray da = block.getDataArray(array3.id());
+
+    nix::hdf5::AttributeCache::resetCounters();
+    CPPUNIT_ASSERT(*da.label() == "label");
+    size_t misses = nix::hdf5::AttributeCache::misses();
+    CPPUNIT_ASSERT(misses <= 1);
+    CPPUNIT_ASSERT(*da.unit() == "Hz");
+    CPPUNIT_ASSERT(da.name() == "one_d");
+    CPPUNIT_ASSERT(da.definition() == nix::none);
+    CPPUNIT_ASSERT(nix::hdf5::AttributeCache::misses() == misses);
+    CPPUNIT_ASSERT(nix::hdf5::AttributeCache::hits() >= 3);
+
+    // setters write through to the file and the cache
+    da.label("other");
+    da.expansionOrigin(2.5);
+    CPPUNIT_ASSERT(*da.label() == "other");
+    CPPUNIT_ASSERT(*da.expansionOrigin() == 2.5);
+    da.label(boost::none);
+    CPPUNIT_ASSERT(da.label() == nix::none);
+    CPPUNIT_ASSERT(nix::hdf5::AttributeCache::misses() == misses);
+
+    file.attributeCache(false);
+    nix::DataArray fresh = block.getDataArray(array3.id());
+    CPPUNIT_ASSERT(fresh.label() == nix::none);
+    CPPUNIT_ASSERT(*fresh.expansionOrigin() == 2.5);
+}
+
+void TestDataArray::testChunkCache()
+{
+    nix::NDSize chunks = array2.dataChunks();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), chunks.size());
+
+    nix::ChunkCache defaults;
+    nix::ChunkCache cache = nix::ChunkCache::forAccess({64, 64}, 8, {1000, 1});
+    CPPUNIT_ASSERT(cache.bytes >= 17 * 64 * 64 * 8);
+    CPPUNIT_ASSERT(cache.slots >= 17 * 100);
+    CPPUNIT_ASSERT_EQUAL(defaults.preemption, cache.preemption);
+    cache = nix::ChunkCache::forAccess({64, 64}, 8, {128, 64});
+    CPPUNIT_ASSERT_EQUAL(1.0, cache.preemption);
+
+    cache.slots = 10007;
+    cache.bytes = 4 * 1024 * 1024;
+    array2.chunkCache(cache);
+    nix::ChunkCache current = array2.chunkCache();
+    CPPUNIT_ASSERT_EQUAL(cache.slots, current.slots);
+    CPPUNIT_ASSERT_EQUAL(cache.bytes, current.bytes);
+
+    std::vector<double> column(20);
+    array2.getData(nix::DataType::Double, column.data(), {20, 1}, {0, 3});
+
+    array2.chunkCacheFor({20, 1});
+    current = array2.chunkCache();
+    CPPUNIT_ASSERT(current.bytes >= defaults.bytes);
+    CPPUNIT_ASSERT(current.slots >= defaults.slots);
+}
+
+void TestDataArray::testCompression()
+{
+    CPPUNIT_ASSERT(!array2.compression().enabled());
+
+    nix::Compression filters = nix::Compression::deflateWith(4, true);
+    filters.fletcher32 = true;
+
+    std::vector<int16_t> trace(4096);
+    for (size_t i = 0; i < trace.size(); i++) {
+        trace[i] = static_cast<int16_t>(1000 * std::sin(i / 100.0));
+    }
+
+    nix::DataArray da = block.createDataArray("compressed", "trace", trace, nix::DataType::Int16, filters);
+    CPPUNIT_ASSERT(da.compression() == filters);
+    CPPUNIT_ASSERT(block.getDataArray(da.id()).compression() == filters);
+
+    std::vector<int16_t> check;
+    da.getData(check);
+    CPPUNIT_ASSERT(check == trace);
+}
+
+void TestDataArray::testChunking()
+{
+    nix::Chunking chunking;
+    CPPUNIT_ASSERT(!chunking.hasHints());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize{}, chunking.chunkShape({0, 64}, 2));
+
+    // appended along time, read per channel
+    chunking = nix::Chunking::growingAlong(0);
+    chunking.read_axis = 0;
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({32768, 1}), chunking.chunkShape({0, 64}, 2));
+
+    // appended along time, whole rows stay in one chunk
+    chunking.read_axis = boost::none;
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({512, 64}), chunking.chunkShape({0, 64}, 2));
+
+    chunking = nix::Chunking::forAccess({1024, 64});
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1024, 32}), chunking.chunkShape({0, 64}, 2));
+
+    chunking = nix::Chunking::growingAlong(2);
+    CPPUNIT_ASSERT_THROW(chunking.chunkShape({0, 64}, 2), nix::InvalidRank);
+
+    chunking = nix::Chunking::growingAlong(0);
+    chunking.read_axis = 0;
+    nix::DataArray da = block.createDataArray("channels", "ephys", nix::DataType::Int16, {0, 64},
+                                              nix::Compression(), chunking);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({32768, 1}), da.dataChunks());
+
+    chunking = nix::Chunking();
+    chunking.chunks = {16, 16};
+    da = block.createDataArray("explicit", "ephys", nix::DataType::Int16, {0, 64},
+                               nix::Compression(), chunking);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({16, 16}), da.dataChunks());
+}
+
+void TestDataArray::testAppender()
+{
+    // append along the first axis; the buffer holds one chunk of 5 rows
+    nix::Chunking chunking;
+    chunking.chunks = {5, 4};
+    nix::DataArray rows = block.createDataArray("append_rows", "double", nix::DataType::Int32, {0, 4},
+                                                nix::Compression(), chunking);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5, 4}), rows.dataChunks());
+
+    std::vector<int32_t> expected;
+    auto append_rows = [&](nix::DataAppender &app, int32_t value, nix::ndsize_t n) {
+        std::vector<int32_t> block_rows(n * 4, value);
+        expected.insert(expected.end(), block_rows.begin(), block_rows.end());
+        app.append(nix::DataType::Int32, block_rows.data(), {n, nix::ndsize_t(4)});
+    };
+    auto stored = [&](nix::ndsize_t first, nix::ndsize_t n) {
+        std::vector<int32_t> values(n * 4);
+        rows.getData(nix::DataType::Int32, values.data(), {n, nix::ndsize_t(4)}, {first, nix::ndsize_t(0)});
+        return values == std::vector<int32_t>(expected.begin() + first * 4, expected.begin() + (first + n) * 4);
+    };
+
+    {
+        nix::DataAppender app = rows.appender(0, 5 * 4 * sizeof(int32_t));
+
+        // a block that does not fit into the rest of the buffer flushes it
+        append_rows(app, 1, 3);
+        append_rows(app, 2, 3);
+        CPPUNIT_ASSERT(stored(0, 3));
+
+        // a full buffer is flushed
+        append_rows(app, 3, 2);
+        CPPUNIT_ASSERT(stored(3, 5));
+
+        // a block larger than the buffer is written directly
+        append_rows(app, 4, 12);
+        CPPUNIT_ASSERT(stored(8, 12));
+
+        for (int32_t i = 5; i < 38; i++) {
+            append_rows(app, i, 3);
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(119), app.size());
+        CPPUNIT_ASSERT_THROW(app.append(nix::DataType::Int32, expected.data(), {1, 3}),
+                             nix::IncompatibleDimensions);
+        CPPUNIT_ASSERT_THROW(app.append(nix::DataType::Double, expected.data(), {1, 4}), std::invalid_argument);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({119, 4}), rows.dataExtent());
+    CPPUNIT_ASSERT(stored(0, 119));
+
+    // append along the last axis, blocks of a partly filled buffer have to be moved together
+    nix::DataArray cols = block.createDataArray("append_cols", "double", nix::DataType::Double, {2, 0});
+    nix::DataAppender app = cols.appender(1, 1024);
+    std::vector<double> block1 = {1, 2, 3, 4};
+    std::vector<double> block2 = {5, 6};
+    app.append(nix::DataType::Double, block1.data(), {2, 2});
+    app.append(nix::DataType::Double, block2.data(), {2, 1});
+    app.close();
+
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({2, 3}), cols.dataExtent());
+    std::vector<double> values(6);
+    cols.getData(nix::DataType::Double, values.data(), {2, 3}, {0, 0});
+    std::vector<double> expected_cols = {1, 2, 5, 3, 4, 6};
+    CPPUNIT_ASSERT(values == expected_cols);
+}
+
+void TestDataArray::testAsyncAppender()
+{
+    nix::DataArray da = block.createDataArray("async", "double", nix::DataType::Int32, {0, 3},
+                                              nix::Compression(), nix::Chunking::growingAlong(0));
+    std::vector<int32_t> expected;
+    {
+        nix::AsyncAppender app(da, 0, 4);
+        for (int32_t i = 0; i < 50; i++) {
+            std::vector<int32_t> rows(2 * 3, i);
+            expected.insert(expected.end(), rows.begin(), rows.end());
+            CPPUNIT_ASSERT(app.append(nix::DataType::Int32, rows.data(), {2, 3}));
+        }
+        CPPUNIT_ASSERT_THROW(app.append(nix::DataType::String, expected.data(), {1, 3}), std::invalid_argument);
+        app.flush();
+
+        nix::AsyncAppender::Stats stats = app.stats();
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), stats.enqueued);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), stats.written);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), stats.dropped);
+        size_t measured = 0;
+        for (size_t n : stats.latency) {
+            measured += n;
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), measured);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({100, 3}), da.dataExtent());
+    std::vector<int32_t> check(expected.size());
+    da.getData(nix::DataType::Int32, check.data(), {100, 3}, {0, 0});
+    CPPUNIT_ASSERT(check == expected);
+
+    // blocks that do not fit into the ring buffer go to the spill file, in order
+    nix::DataArray spilled = block.createDataArray("async_spill", "double", nix::DataType::Double, {0});
+    nix::AsyncAppender app(spilled, 0, 1, nix::AsyncAppender::Backpressure::Spill);
+    std::vector<double> values(1000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i);
+        app.append(nix::DataType::Double, &values[i], {1});
+    }
+    app.close();
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1000}), spilled.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1000), app.stats().written);
+
+    std::vector<double> read(values.size());
+    spilled.getData(nix::DataType::Double, read.data(), {1000}, {0});
+    CPPUNIT_ASSERT(read == values);
+    CPPUNIT_ASSERT_THROW(app.append(nix::DataType::Double, values.data(), {1}), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(nix::AsyncAppender(spilled, 1), nix::InvalidRank);
+}
+
+void TestDataArray::testDataStream()
+{
+    nix::Chunking chunking;
+    chunking.chunks = {8, 5};
+    nix::DataArray da = block.createDataArray("stream", "double", nix::DataType::Int32, {37, 23},
+                                              nix::Compression(), chunking);
+    std::vector<int32_t> values(37 * 23);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+    da.setData(nix::DataType::Int32, values.data(), {37, 23}, {0, 0});
+
+    // blocks of two chunks, read ahead
+    std::vector<int> seen(values.size(), 0);
+    {
+        nix::DataStream stream(da, nix::DataType::Double, 2, 2 * 8 * 5 * sizeof(double));
+        CPPUNIT_ASSERT_EQUAL(nix::NDSize({8, 10}), stream.blockShape());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5 * 3), stream.blockCount());
+
+        size_t nblocks = 0;
+        for (const nix::DataStream::Block &b : stream) {
+            CPPUNIT_ASSERT(b.offset[0] % 8 == 0 && b.offset[1] % 10 == 0);
+            CPPUNIT_ASSERT_THROW(b.data<int32_t>(), std::invalid_argument);
+            const double *x = b.data<double>();
+            for (ndsize_t i = 0; i < b.count[0]; i++) {
+                for (ndsize_t j = 0; j < b.count[1]; j++) {
+                    const size_t index = (b.offset[0] + i) * 23 + b.offset[1] + j;
+                    CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[index]), x[i * b.count[1] + j]);
+                    seen[index]++;
+                }
+            }
+            nblocks++;
+        }
+        CPPUNIT_ASSERT_EQUAL(stream.blockCount(), nblocks);
+        CPPUNIT_ASSERT(!stream.next());
+    }
+    CPPUNIT_ASSERT(std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; }));
+
+    // a view that is not aligned to the chunks, read in the calling thread
+    nix::DataView view(da, {30, 17}, {3, 2});
+    nix::DataStream stream(view, nix::DataType::Int32, 0, 8 * 5 * sizeof(int32_t));
+    CPPUNIT_ASSERT(stream.next());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({0, 0}), stream.block().offset);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5, 3}), stream.block().count);
+
+    ndsize_t total = stream.block().size();
+    while (stream.next()) {
+        const nix::DataStream::Block &b = stream.block();
+        const int32_t *x = b.data<int32_t>();
+        CPPUNIT_ASSERT_EQUAL(values[(3 + b.offset[0]) * 23 + 2 + b.offset[1]], x[0]);
+        total += b.size();
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(30 * 17), total);
+}
+
+void TestDataArray::testReferringEntities()
+{
+    nix::DataArray extents = block.createDataArray("extents", "double", nix::DataType::Double, nix::NDSize({ 20, 20 }));
+
+    // links that exist when the index is built
+    nix::Tag t1 = block.createTag("t1", "tag", {1.0});
+    t1.addReference(array3);
+    nix::Feature f1 = t1.createFeature(array2, nix::LinkType::Untagged);
+    nix::MultiTag m1 = block.createMultiTag("m1", "mtag", array2);
+    m1.extents(extents);
+
+    std::vector<nix::Tag> tags = array3.referringTags();
+    CPPUNIT_ASSERT(tags.size() == 1 && tags[0].id() == t1.id());
+    CPPUNIT_ASSERT(array3.referringMultiTags().empty());
+    CPPUNIT_ASSERT(array2.referringTags().size() == 1);
+    CPPUNIT_ASSERT(array2.referringMultiTags().size() == 1);
+    CPPUNIT_ASSERT(array2.referringFeatures()[0].id() == f1.id());
+    CPPUNIT_ASSERT(extents.referringMultiTags()[0].id() == m1.id());
+    CPPUNIT_ASSERT(array1.referringTags().empty());
+
+    // links that are changed afterwards
+    nix::Tag t2 = block.createTag("t2", "tag", {1.0});
+    t2.addReference(array3);
+    nix::Feature f2 = t2.createFeature(array3, nix::LinkType::Tagged);
+    m1.addReference(array3);
+    tags = array3.referringTags();
+    CPPUNIT_ASSERT(tags.size() == 2 && tags[1].id() == t2.id());
+    CPPUNIT_ASSERT(array3.referringTags(nix::util::NameFilter<nix::Tag>("t2")).size() == 1);
+    CPPUNIT_ASSERT(array3.referringMultiTags().size() == 1);
+    CPPUNIT_ASSERT(array3.referringFeatures().size() == 1);
+
+    m1.extents(boost::none);
+    CPPUNIT_ASSERT(extents.referringMultiTags().empty());
+
+    f2.data(array1);
+    CPPUNIT_ASSERT(array3.referringFeatures().empty());
+    CPPUNIT_ASSERT(array1.referringTags()[0].id() == t2.id());
+
+    CPPUNIT_ASSERT(t2.removeReference(array3));
+    CPPUNIT_ASSERT(array3.referringTags().size() == 1);
+    CPPUNIT_ASSERT(t2.deleteFeature(f2));
+    CPPUNIT_ASSERT(array1.referringTags().empty());
+
+    CPPUNIT_ASSERT(block.deleteTag(t1));
+    CPPUNIT_ASSERT(array3.referringTags().empty());
+    CPPUNIT_ASSERT(array2.referringFeatures().empty());
+    CPPUNIT_ASSERT(block.deleteMultiTag(m1));
+    CPPUNIT_ASSERT(array2.referringMultiTags().empty());
+    CPPUNIT_ASSERT(array3.referringMultiTags().empty());
+}
+
 void TestDataArray::testDimension()
 {
     std::vector<nix::Dimension> dims;
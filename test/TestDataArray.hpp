@@ -42,9 +42,19 @@ public:
     void testName();
     void testDefinition();
     void testData();
+    void testDataExtentHandles();
     void testPolynomial();
+    void testPolynomialConversion();
     void testLabel();
     void testUnit();
+    void testAttributeCache();
+    void testChunkCache();
+    void testCompression();
+    void testChunking();
+    void testAppender();
+    void testAsyncAppender();
+    void testDataStream();
+    void testReferringEntities();
     void testDimension();
     void testAliasRangeDimension();
     void testOperator();
@@ -59,9 +69,19 @@ private:
     CPPUNIT_TEST(testName);
     CPPUNIT_TEST(testDefinition);
     CPPUNIT_TEST(testData);
+    CPPUNIT_TEST(testDataExtentHandles);
     CPPUNIT_TEST(testPolynomial);
+    CPPUNIT_TEST(testPolynomialConversion);
     CPPUNIT_TEST(testLabel);
     CPPUNIT_TEST(testUnit);
+    CPPUNIT_TEST(testAttributeCache);
+    CPPUNIT_TEST(testChunkCache);
+    CPPUNIT_TEST(testCompression);
+    CPPUNIT_TEST(testChunking);
+    CPPUNIT_TEST(testAppender);
+    CPPUNIT_TEST(testAsyncAppender);
+    CPPUNIT_TEST(testDataStream);
+    CPPUNIT_TEST(testReferringEntities);
     CPPUNIT_TEST(testDimension);
     CPPUNIT_TEST(testAliasRangeDimension);
     CPPUNIT_TEST(testOperator);
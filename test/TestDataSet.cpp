@@ -191,8 +191,13 @@ void TestDataSet::testDataType() {
         std::cerr << _types[i].name << std::endl;
         hdf5::DataSet ds = h5group.createData(_types[i].name, _types[i].dtype, dims);
         CPPUNIT_ASSERT_EQUAL(ds.dataType(), _types[i].dtype);
+
+        const hdf5::h5x::DataType &memType = hdf5::cached_h5_memtype(_types[i].dtype);
+        CPPUNIT_ASSERT(memType.isValid());
+        CPPUNIT_ASSERT_EQUAL(memType.h5id(), hdf5::cached_h5_memtype(_types[i].dtype).h5id());
     }
 
+    CPPUNIT_ASSERT_THROW(hdf5::cached_h5_memtype(nix::DataType::Nothing), std::invalid_argument);
 }
 
 
@@ -413,6 +418,11 @@ void TestDataSet::testValueIO() {
 
     test_val_generic(h5group, std::string("String Value"), "stringValue");
 
+    // the value types are shared
+    const nix::hdf5::h5x::DataType &fileType = nix::hdf5::DataSet::fileTypeForValue(nix::DataType::Double);
+    CPPUNIT_ASSERT_EQUAL(&fileType, &nix::hdf5::DataSet::fileTypeForValue(nix::DataType::Double));
+    CPPUNIT_ASSERT(&fileType != &nix::hdf5::DataSet::memTypeForValue(nix::DataType::Double));
+    CPPUNIT_ASSERT_EQUAL(6, H5Tget_nmembers(fileType.h5id()));
 }
 
 
@@ -12,6 +12,7 @@
 #include "TestDimension.hpp"
 
 #include <nix/util/util.hpp>
+#include <nix/util/dataAccess.hpp>
 #include <nix/valid/validate.hpp>
 
 using namespace std;
@@ -418,6 +419,19 @@ void TestDimension::testRangeDimIndexOf() {
     CPPUNIT_ASSERT(rd.indexOf(257.28) == 4);
     CPPUNIT_ASSERT(rd.indexOf(-257.28) == 0);
 
+    // batch lookups, sorted and unsorted, both search strategies
+    std::vector<double> sorted = {-257.28, -100., -70., -50., 5.0, 10.0, 257.28};
+    std::vector<double> unsorted = {5.0, 257.28, -100., -50., 10.0, -257.28, -70.};
+    std::vector<double> single = {-50.};
+    for (const std::vector<double> &positions : {sorted, unsorted, single}) {
+        std::vector<size_t> indices = rd.indexOf(positions);
+        CPPUNIT_ASSERT_EQUAL(positions.size(), indices.size());
+        for (size_t i = 0; i < positions.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(rd.indexOf(positions[i]), indices[i]);
+        }
+    }
+    CPPUNIT_ASSERT(rd.indexOf(std::vector<double>()).empty());
+
     data_array.deleteDimension(d.index());
 }
 
@@ -437,7 +451,21 @@ void TestDimension::testRangeDimTickAt() {
     CPPUNIT_ASSERT(rd[4] == 100.);
     CPPUNIT_ASSERT_THROW(rd[10], OutOfBounds);
 
+    // cached ticks follow changes made through other handles
+    RangeDimension other = data_array.getDimension(d.index()).asRangeDimension();
+    other.ticks({-1.0, 1.0});
+    CPPUNIT_ASSERT(rd.tickAt(1) == 1.0);
+    CPPUNIT_ASSERT_THROW(rd.tickAt(4), OutOfBounds);
+
     data_array.deleteDimension(d.index());
+
+    DataArray times = block.createDataArray("times", "test", DataType::Double, NDSize({3}));
+    times.setData(std::vector<double>{1.0, 2.0, 3.0});
+    RangeDimension alias = times.appendAliasRangeDimension();
+    CPPUNIT_ASSERT(alias.tickAt(2) == 3.0);
+    times.setData(std::vector<double>{1.0, 2.0, 4.0});
+    CPPUNIT_ASSERT(alias.tickAt(2) == 4.0);
+    CPPUNIT_ASSERT(alias.indexOf(3.5) == 2);
 }
 
 void TestDimension::testRangeDimAxis() {
@@ -462,3 +490,49 @@ void TestDimension::testRangeDimAxis() {
     CPPUNIT_ASSERT_THROW(rd.axis(10), OutOfBounds);
     CPPUNIT_ASSERT_THROW(rd.axis(2, 10), OutOfBounds);
 }
+
+void TestDimension::testDimensionMapper() {
+    SampledDimension sd = data_array.appendSampledDimension(0.5);
+    sd.unit("ms");
+    sd.offset(1.0);
+    RangeDimension rd = data_array.appendRangeDimension({1.0, 2.0, 4.0, 8.0});
+    rd.unit("ms");
+    SetDimension setd = data_array.appendSetDimension();
+    setd.labels({"a", "b", "c"});
+
+    std::vector<double> seconds = {0.001, 0.0013, 0.0021, 0.0079, 0.01};
+    DimensionMapper sampled(sd, "s");
+    DimensionMapper range(rd, "s");
+    CPPUNIT_ASSERT(sampled.dimensionType() == DimensionType::Sample);
+    CPPUNIT_ASSERT(range.dimensionType() == DimensionType::Range);
+
+    std::vector<size_t> sampled_idx = sampled.indexOf(seconds);
+    std::vector<size_t> range_idx = range.indexOf(seconds);
+    for (size_t i = 0; i < seconds.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(util::positionToIndex(seconds[i], "s", sd), sampled_idx[i]);
+        CPPUNIT_ASSERT_EQUAL(util::positionToIndex(seconds[i], "s", rd), range_idx[i]);
+        CPPUNIT_ASSERT_EQUAL(sampled_idx[i], sampled.indexOf(seconds[i]));
+    }
+
+    std::vector<double> positions = sampled.positionAt(std::vector<size_t>{0, 2, 4});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.001, positions[0], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.002, positions[1], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.003, positions[2], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.008, range.positionAt(3), 1e-12);
+    CPPUNIT_ASSERT_THROW(range.positionAt(4), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(sampled.indexOf(std::vector<double>{0.001, 0.0}), OutOfBounds);
+
+    // positions without unit are in the unit of the dimension
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), DimensionMapper(sd).indexOf(2.0));
+
+    DimensionMapper set(setd);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), set.indexOf(1.6));
+    CPPUNIT_ASSERT_EQUAL(2.0, set.positionAt(2));
+    CPPUNIT_ASSERT_THROW(set.indexOf(std::vector<double>{1.0, 4.0}), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(DimensionMapper(setd, "ms"), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(DimensionMapper(rd, "mV"), IncompatibleDimensions);
+
+    for (size_t i = data_array.dimensionCount(); i > 0; i--) {
+        data_array.deleteDimension(i);
+    }
+}
@@ -50,6 +50,7 @@ private:
     CPPUNIT_TEST(testRangeDimIndexOf);
     CPPUNIT_TEST(testRangeDimTickAt);
     CPPUNIT_TEST(testRangeDimAxis);
+    CPPUNIT_TEST(testDimensionMapper);
 
     CPPUNIT_TEST_SUITE_END ();
 
@@ -86,5 +87,7 @@ public:
     void testRangeDimIndexOf();
     void testRangeDimTickAt();
     void testRangeDimAxis();
+
+    void testDimensionMapper();
 };
 
@@ -166,6 +166,67 @@ void TestFile::testSectionAccess() {
 }
 
 
+void TestFile::testMetadataTree() {
+    Section root = file_open.createSection("root", "session");
+    root.definition("a recording session");
+    Section sub = root.createSection("subject", "subject");
+    Section other = file_open.createSection("other", "stimulus");
+    sub.link(other);
+
+    Property p = sub.createProperty("weight", {Value(12.5), Value(13.5)});
+    p.unit("g");
+    Property q = root.createProperty("comment", Value("short"));
+    root.createProperty("empty", DataType::Int32);
+
+    MetadataTree tree = file_open.loadMetadataTree();
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), tree.sectionCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), tree.totalSectionCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), tree.totalPropertyCount());
+    CPPUNIT_ASSERT(!tree.getSection("missing"));
+    CPPUNIT_ASSERT_THROW(tree.getSection(2), nix::OutOfBounds);
+
+    MetadataTree::Section troot = tree.getSection(root.id());
+    CPPUNIT_ASSERT(troot.name() == "root");
+    CPPUNIT_ASSERT(troot.type() == "session");
+    CPPUNIT_ASSERT(*troot.definition() == "a recording session");
+    CPPUNIT_ASSERT(!troot.repository());
+    CPPUNIT_ASSERT(troot.createdAt() == root.createdAt());
+    CPPUNIT_ASSERT(troot.updatedAt() == root.updatedAt());
+    CPPUNIT_ASSERT(!troot.parent());
+    CPPUNIT_ASSERT(!troot.link());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), troot.propertyCount());
+
+    MetadataTree::Section tsub = troot.getSection("subject");
+    CPPUNIT_ASSERT(tsub.id() == sub.id());
+    CPPUNIT_ASSERT(tsub.parent().id() == root.id());
+    CPPUNIT_ASSERT(tsub.link().id() == other.id());
+    CPPUNIT_ASSERT(tree.findSection(sub.id()).name() == "subject");
+
+    MetadataTree::Property tp = tsub.getProperty(0);
+    CPPUNIT_ASSERT(tp.id() == p.id());
+    CPPUNIT_ASSERT(tp.name() == "weight");
+    CPPUNIT_ASSERT(*tp.unit() == "g");
+    CPPUNIT_ASSERT(!tp.definition());
+    CPPUNIT_ASSERT(tp.dataType() == DataType::Double);
+    CPPUNIT_ASSERT(tp.values() == p.values());
+    CPPUNIT_ASSERT(tp.section().id() == sub.id());
+
+    MetadataTree::Property tq = troot.getProperty(q.id());
+    CPPUNIT_ASSERT(tq.values() == q.values());
+    CPPUNIT_ASSERT(tq.dataType() == DataType::String);
+
+    MetadataTree::Property te = troot.getProperty("empty");
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), te.valueCount());
+    CPPUNIT_ASSERT(te.dataType() == DataType::Int32);
+
+    // the tree is a snapshot
+    root.createSection("later", "subject");
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), troot.sectionCount());
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), MetadataTree().sectionCount());
+}
+
+
 void TestFile::testOperators(){
     CPPUNIT_ASSERT(file_null == false);
     CPPUNIT_ASSERT(file_null == none);
@@ -36,6 +36,7 @@ private:
     CPPUNIT_TEST(testUpdatedAt);
     CPPUNIT_TEST(testBlockAccess);
     CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testMetadataTree);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
     CPPUNIT_TEST_SUITE_END ();
@@ -56,6 +57,7 @@ public:
     void testUpdatedAt();
     void testBlockAccess();
     void testSectionAccess();
+    void testMetadataTree();
     void testOperators();
     void testReopen();
 };
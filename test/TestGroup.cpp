@@ -14,6 +14,8 @@
 
 #include <nix/hdf5/FileHDF5.hpp>
 
+#include <algorithm>
+
 unsigned int & TestGroup::open_mode()
 {
     static unsigned int openMode = H5F_ACC_TRUNC;
@@ -203,6 +205,181 @@ void TestGroup::testOpen() {
 
 }
 
+void TestGroup::testFindByAttribute() {
+    nix::hdf5::Group root(h5group, true);
+    nix::hdf5::Group container = root.openGroup("indexed", true);
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 5; i++) {
+        nix::hdf5::Group g = container.openGroup("child_" + std::to_string(i), true);
+        ids.push_back(nix::util::createId());
+        g.setAttr("entity_id", ids.back());
+    }
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        boost::optional<nix::hdf5::Group> g = container.findGroupByNameOrAttribute("entity_id", ids[i]);
+        CPPUNIT_ASSERT(g);
+        CPPUNIT_ASSERT_EQUAL(container.name() + "/child_" + std::to_string(i), g->name());
+    }
+
+    // links added after the index was built
+    nix::hdf5::Group late = container.openGroup("late", true);
+    std::string late_id = nix::util::createId();
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", late_id));
+    late.setAttr("entity_id", late_id);
+    CPPUNIT_ASSERT(container.findGroupByNameOrAttribute("entity_id", late_id));
+
+    // removal and re-creation under the same name
+    container.removeGroup("child_2");
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", ids[2]));
+    nix::hdf5::Group again = container.openGroup("child_2", true);
+    std::string again_id = nix::util::createId();
+    again.setAttr("entity_id", again_id);
+    CPPUNIT_ASSERT(container.findGroupByNameOrAttribute("entity_id", again_id));
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", ids[2]));
+
+    // renaming
+    container.renameGroup("child_3", "child_renamed");
+    boost::optional<nix::hdf5::Group> renamed = container.findGroupByNameOrAttribute("entity_id", ids[3]);
+    CPPUNIT_ASSERT(renamed);
+    CPPUNIT_ASSERT_EQUAL(container.name() + "/child_renamed", renamed->name());
+
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", nix::util::createId()));
+    CPPUNIT_ASSERT(!container.findDataByNameOrAttribute("entity_id", ids[0]));
+
+    // removing all links of an object also updates the index of the other group
+    nix::hdf5::Group other = root.openGroup("indexed_other", true);
+    other.createLink(container.openGroup("child_4", false), "alias");
+    CPPUNIT_ASSERT(other.findGroupByNameOrAttribute("entity_id", ids[4]));
+    CPPUNIT_ASSERT(container.removeAllLinks("child_4"));
+    CPPUNIT_ASSERT(!other.findGroupByNameOrAttribute("entity_id", ids[4]));
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", ids[4]));
+    nix::hdf5::Group replacement = other.openGroup("alias", true);
+    std::string replacement_id = nix::util::createId();
+    replacement.setAttr("entity_id", replacement_id);
+    CPPUNIT_ASSERT(other.findGroupByNameOrAttribute("entity_id", replacement_id));
+
+    // objects without the attribute are inspected again once links are added
+    nix::hdf5::Group plain = container.openGroup("plain", true);
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", nix::util::createId()));
+    CPPUNIT_ASSERT(!container.findGroupByNameOrAttribute("entity_id", nix::util::createId()));
+    std::string plain_id = nix::util::createId();
+    plain.setAttr("entity_id", plain_id);
+    container.openGroup("plain_2", true);
+    CPPUNIT_ASSERT(container.findGroupByNameOrAttribute("entity_id", plain_id));
+
+    container.releaseIndexes();
+    CPPUNIT_ASSERT(container.findGroupByNameOrAttribute("entity_id", ids[0]));
+}
+
+void TestGroup::testVisitObjects() {
+    nix::hdf5::Group root(h5group, true);
+    nix::hdf5::Group container = root.openGroup("visited", true);
+
+    container.openGroup("b_group", true);
+    container.openGroup("a_group", true);
+    container.setData("c_data", std::vector<int>{1, 2, 3});
+
+    std::vector<std::string> names;
+    std::vector<H5O_type_t> types;
+    container.visitObjects([&](const std::string &name, H5O_type_t type, const nix::hdf5::LocID &obj) {
+        CPPUNIT_ASSERT(obj.isValid());
+        names.push_back(name);
+        types.push_back(type);
+        return true;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(container.objectCount()), names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(container.objectName(i), names[i]);
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+        CPPUNIT_ASSERT(types[i] == (names[i] == "c_data" ? H5O_TYPE_DATASET : H5O_TYPE_GROUP));
+    }
+
+    size_t visited = 0;
+    container.visitObjects([&visited](const std::string &name, H5O_type_t type, const nix::hdf5::LocID &obj) {
+        visited++;
+        return false;
+    });
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), visited);
+
+    CPPUNIT_ASSERT_THROW(container.visitObjects([](const std::string &name, H5O_type_t type, const nix::hdf5::LocID &obj) -> bool {
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+
+    std::vector<nix::hdf5::Group> groups = container.groups();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), groups.size());
+    for (const auto &g : groups) {
+        CPPUNIT_ASSERT(g.name() != container.name() + "/c_data");
+    }
+
+    std::vector<nix::hdf5::DataSet> dsets = container.dataSets();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), dsets.size());
+    CPPUNIT_ASSERT_EQUAL(container.name() + "/c_data", dsets[0].name());
+}
+
+void TestGroup::testMatchingLinks() {
+    nix::hdf5::Group root(h5group, true);
+    nix::hdf5::Group container = root.openGroup("matched", true);
+
+    const std::vector<std::string> names = {"c", "a", "b"};
+    for (const auto &name : names) {
+        nix::hdf5::Group g = container.openGroup(name, true);
+        g.setAttr("entity_id", "id_" + name);
+        g.setAttr("type", name == "b" ? std::string("odd") : std::string("even"));
+    }
+    container.setData("d", std::vector<int>{1, 2, 3});
+
+    typedef nix::util::Match Match;
+    const Match::Field by_name = Match::Field::Name;
+
+    std::vector<std::string> all = container.matchingLinks(Match(), by_name);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), all.size());
+
+    // matches are returned in link order
+    auto in_link_order = [&all](const std::vector<std::string> &subset) {
+        std::vector<std::string> ordered;
+        std::copy_if(all.begin(), all.end(), std::back_inserter(ordered), [&subset](const std::string &name) {
+            return std::find(subset.begin(), subset.end(), name) != subset.end();
+        });
+        return ordered;
+    };
+
+    std::vector<std::string> links;
+
+    links = container.matchingLinks(Match(Match::Field::Name, {"a"}), by_name);
+    CPPUNIT_ASSERT(links == std::vector<std::string>{"a"});
+    CPPUNIT_ASSERT(container.matchingLinks(Match(Match::Field::Name, {"x"}), by_name).empty());
+    CPPUNIT_ASSERT(container.matchingLinks(Match(Match::Field::Name, {""}), by_name).empty());
+
+    links = container.matchingLinks(Match(Match::Field::Id, {"id_c", "id_a", "id_x"}), by_name);
+    CPPUNIT_ASSERT(links == in_link_order({"a", "c"}));
+
+    links = container.matchingLinks(Match(Match::Field::Type, {"even"}), by_name);
+    CPPUNIT_ASSERT(links == in_link_order({"a", "c"}));
+
+    // link names that are ids, as in reference groups
+    links = container.matchingLinks(Match(Match::Field::Name, {"b", "c"}), Match::Field::Id);
+    CPPUNIT_ASSERT(links.empty());
+    links = container.matchingLinks(Match(Match::Field::Id, {"b", "c"}), Match::Field::Id);
+    CPPUNIT_ASSERT(links == in_link_order({"b", "c"}));
+
+    std::vector<nix::hdf5::Group> groups = container.groups(Match(Match::Field::Name, {"b", "d"}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), groups.size());
+    CPPUNIT_ASSERT_EQUAL(container.name() + "/b", groups[0].name());
+
+    std::vector<nix::hdf5::DataSet> dsets = container.dataSets(Match(Match::Field::Name, {"b", "d"}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), dsets.size());
+    CPPUNIT_ASSERT_EQUAL(container.name() + "/d", dsets[0].name());
+
+    nix::util::NameFilter<nix::DataArray> filter("a");
+    std::function<bool(const nix::DataArray &)> erased = filter;
+    CPPUNIT_ASSERT(Match::of(erased).field == Match::Field::Name);
+    erased = [](const nix::DataArray &da) { return true; };
+    CPPUNIT_ASSERT(Match::of(erased).field == Match::Field::All);
+}
+
 void TestGroup::testRefCount() {
 
     hid_t ha = H5Gopen2(h5file, "/", H5P_DEFAULT);
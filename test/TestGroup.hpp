@@ -47,6 +47,9 @@ public:
     void testArray();
 
     void testOpen();
+    void testFindByAttribute();
+    void testVisitObjects();
+    void testMatchingLinks();
 
     template<typename T>
     static void assert_vectors_equal(std::vector<T> &a, std::vector<T> &b) {
@@ -73,6 +76,9 @@ private:
     CPPUNIT_TEST_SUITE(TestGroup);
     CPPUNIT_TEST(testRefCount);
     CPPUNIT_TEST(testOpen);
+    CPPUNIT_TEST(testFindByAttribute);
+    CPPUNIT_TEST(testVisitObjects);
+    CPPUNIT_TEST(testMatchingLinks);
     CPPUNIT_TEST(testBaseTypes);
     CPPUNIT_TEST(testVector);
     CPPUNIT_TEST(testMultiArray);
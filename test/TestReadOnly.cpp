@@ -11,6 +11,7 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/Exception.hpp>
+#include <nix/hdf5/FileHDF5.hpp>
 
 #include <ctime>
 
@@ -19,6 +20,24 @@ using namespace nix;
 using namespace valid;
 
 
+// add a fixed-length string attribute, which nix itself never writes
+static void add_fixed_length_attr(const std::string &path, const std::string &name) {
+    hid_t h5file = H5Fopen("test_read_only.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+    hid_t obj = H5Oopen(h5file, path.c_str(), H5P_DEFAULT);
+    hid_t type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(type, 8);
+    hid_t space = H5Screate(H5S_SCALAR);
+    hid_t attr = H5Acreate(obj, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, type, "12345678");
+
+    H5Aclose(attr);
+    H5Sclose(space);
+    H5Tclose(type);
+    H5Oclose(obj);
+    H5Fclose(h5file);
+}
+
+
 void TestReadOnly::setUp() {
     startup_time = time(NULL);
     File file = File::open("test_read_only.h5", FileMode::Overwrite);
@@ -43,6 +62,7 @@ void TestReadOnly::setUp() {
     MultiTag mtag = block.createMultiTag("tag_one", "test_tag", positions);
     Feature feature = tag.createFeature(data_array, nix::LinkType::Tagged);
     Property property = section.createProperty("doubleProperty", values);
+    block.createSource("source_one", "animal");
     
     section_id = section.id(); feature_id = feature.id(); tag_id = tag.id();
     mtag_id = mtag.id(); property_id = property.id(); block_id = block.id();
@@ -86,3 +106,34 @@ void TestReadOnly::testRead() {
     
     file.close();
 }
+
+
+void TestReadOnly::testFixedLengthAttributes() {
+    add_fixed_length_attr("/data/block_one", "note");
+    add_fixed_length_attr("/metadata/foo_section", "note");
+    add_fixed_length_attr("/metadata/foo_section/properties/doubleProperty", "note");
+    add_fixed_length_attr("/data/block_one/sources/source_one", "note");
+
+    File file = File::open("test_read_only.h5", FileMode::ReadOnly);
+    CPPUNIT_ASSERT(file.attributeCache());
+
+    Block block = file.getBlock(0);
+    CPPUNIT_ASSERT(block.name() == "block_one");
+    CPPUNIT_ASSERT(block.type() == "dataset");
+    CPPUNIT_ASSERT(block.id() == block_id);
+
+    MetadataTree tree = file.loadMetadataTree();
+    CPPUNIT_ASSERT(tree.totalPropertyCount() == 1);
+    MetadataTree::Section section = tree.getSection(section_id);
+    CPPUNIT_ASSERT(section.name() == "foo_section");
+    CPPUNIT_ASSERT(section.type() == "metadata");
+    CPPUNIT_ASSERT(section.getProperty(property_id).name() == "doubleProperty");
+
+    // the section and source indexes read the same groups
+    vector<Section> sections = file.findSections(util::TypeFilter<Section>("metadata"));
+    CPPUNIT_ASSERT(sections.size() == 1 && sections[0].id() == section_id);
+    vector<Source> sources = block.findSources(util::NameFilter<Source>("source_one"));
+    CPPUNIT_ASSERT(sources.size() == 1 && sources[0].type() == "animal");
+
+    file.close();
+}
@@ -33,6 +33,7 @@ private:
     CPPUNIT_TEST_SUITE(TestReadOnly);
 
     CPPUNIT_TEST(testRead);
+    CPPUNIT_TEST(testFixedLengthAttributes);
 
     CPPUNIT_TEST_SUITE_END ();
 
@@ -49,5 +50,6 @@ public:
     void tearDown();
 
     void testRead();
+    void testFixedLengthAttributes();
 
 };
@@ -185,6 +185,49 @@ void TestSection::testFindSection() {
     CPPUNIT_ASSERT(section.findSections(filter_typ2).size() == 8);
 }
 
+void TestSection::testSectionIndex() {
+    Section l1 = section.createSection("l1", "typ1");
+    Section l2 = l1.createSection("l2", "typ2");
+
+    // builds the index
+    CPPUNIT_ASSERT(file.findSections(util::TypeFilter<Section>("typ2")).size() == 1);
+
+    // sections created and deleted later are tracked
+    Section l3 = l2.createSection("l3", "typ2");
+    Section other = section_other.createSection("l1", "typ2");
+    vector<Section> found = file.findSections(util::TypeFilter<Section>("typ2"));
+    CPPUNIT_ASSERT(found.size() == 3);
+    CPPUNIT_ASSERT(found[0].id() == other.id());
+    CPPUNIT_ASSERT(found[1].id() == l2.id());
+    CPPUNIT_ASSERT(found[2].id() == l3.id());
+    CPPUNIT_ASSERT(file.findSections(util::TypeFilter<Section>("typ2"), 2).size() == 2);
+    CPPUNIT_ASSERT(section.findSections(util::NameFilter<Section>("l1")).size() == 1);
+    CPPUNIT_ASSERT(l1.findSections(util::TypeFilter<Section>("typ2"), 1).size() == 1);
+
+    l2.type("typ3");
+    CPPUNIT_ASSERT(section.findSections(util::TypeFilter<Section>("typ2")).size() == 1);
+    CPPUNIT_ASSERT(section.findSections(util::TypeFilter<Section>("typ3")).size() == 1);
+
+    // found sections know their parents
+    found = file.findSections(util::IdFilter<Section>(l3.id()));
+    CPPUNIT_ASSERT(found.size() == 1);
+    CPPUNIT_ASSERT(found[0].parent().id() == l2.id());
+    CPPUNIT_ASSERT(found[0].parent().parent().id() == l1.id());
+    CPPUNIT_ASSERT(found[0].parent().parent().parent().id() == section.id());
+
+    other.link(l3);
+    CPPUNIT_ASSERT(other.link().id() == l3.id());
+    CPPUNIT_ASSERT(other.link().parent().id() == l2.id());
+
+    CPPUNIT_ASSERT(l1.deleteSection(l2));
+    CPPUNIT_ASSERT(file.findSections(util::IdFilter<Section>(l3.id())).empty());
+    CPPUNIT_ASSERT(section.findSections(util::TypeFilter<Section>("typ3")).empty());
+    CPPUNIT_ASSERT(file.deleteSection(section_other));
+    CPPUNIT_ASSERT(file.findSections(util::TypeFilter<Section>("typ2")).empty());
+    CPPUNIT_ASSERT(file.findSections(util::TypeFilter<Section>("typ1")).size() == 1);
+}
+
+
 void TestSection::testFindRelated() {
     /* We create the following tree:
      * 
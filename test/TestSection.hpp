@@ -41,6 +41,7 @@ private:
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testFindSection);
     CPPUNIT_TEST(testFindRelated);
+    CPPUNIT_TEST(testSectionIndex);
     CPPUNIT_TEST(testPropertyAccess);
 
     CPPUNIT_TEST(testOperators);
@@ -71,6 +72,7 @@ public:
     void testSectionAccess();
     void testFindSection();
     void testFindRelated();
+    void testSectionIndex();
     void testPropertyAccess();
 
     void testOperators();
@@ -245,6 +245,42 @@ void TestSource::testFindSource() {
 }
 
 
+void TestSource::testSourceIndex() {
+    Source l1 = source.createSource("l1", "typ1");
+    Source l2 = l1.createSource("l2", "typ2");
+
+    // builds the index
+    CPPUNIT_ASSERT(block.findSources(util::TypeFilter<Source>("typ2")).size() == 1);
+
+    // sources created and deleted later are tracked
+    Source l3 = l2.createSource("l3", "typ2");
+    Source other = source_other.createSource("l1", "typ2");
+    vector<Source> found = block.findSources(util::TypeFilter<Source>("typ2"));
+    CPPUNIT_ASSERT(found.size() == 3);
+    CPPUNIT_ASSERT(found[0].id() == l2.id());
+    CPPUNIT_ASSERT(found[1].id() == l3.id());
+    CPPUNIT_ASSERT(found[2].id() == other.id());
+    CPPUNIT_ASSERT(block.findSources(util::TypeFilter<Source>("typ2"), 2).size() == 2);
+    CPPUNIT_ASSERT(block.findSources(util::NameFilter<Source>("l1")).size() == 2);
+    CPPUNIT_ASSERT(source.findSources(util::NameFilter<Source>("l1")).size() == 1);
+    CPPUNIT_ASSERT(l1.findSources(util::TypeFilter<Source>("typ2"), 1).size() == 1);
+    CPPUNIT_ASSERT(block.findSources(util::IdFilter<Source>(l3.id()))[0].name() == "l3");
+
+    // also for sources that are opened through a data array
+    darray.addSource(l2);
+    darray.sources()[0].type("typ3");
+    CPPUNIT_ASSERT(source.findSources(util::TypeFilter<Source>("typ2")).size() == 1);
+    CPPUNIT_ASSERT(source.findSources(util::TypeFilter<Source>("typ3")).size() == 1);
+
+    CPPUNIT_ASSERT(l1.deleteSource(l2));
+    CPPUNIT_ASSERT(block.findSources(util::IdFilter<Source>(l3.id())).empty());
+    CPPUNIT_ASSERT(source.findSources(util::TypeFilter<Source>("typ3")).empty());
+    CPPUNIT_ASSERT(block.deleteSource(source_other));
+    CPPUNIT_ASSERT(block.findSources(util::TypeFilter<Source>("typ2")).empty());
+    CPPUNIT_ASSERT(block.findSources(util::TypeFilter<Source>("typ1")).size() == 1);
+}
+
+
 void TestSource::testOperators() {
     CPPUNIT_ASSERT(source_null == false);
     CPPUNIT_ASSERT(source_null == none);
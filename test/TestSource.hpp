@@ -37,6 +37,7 @@ private:
     CPPUNIT_TEST(testMetadataAccess);
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testFindSource);
+    CPPUNIT_TEST(testSourceIndex);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -66,6 +67,7 @@ public:
     void testMetadataAccess();
     void testSourceAccess();
     void testFindSource();
+    void testSourceIndex();
 
     void testOperators();
     void testUpdatedAt();
@@ -8,6 +8,8 @@
 
 #include "TestUtil.hpp"
 
+#include <nix/util/units.hpp>
+
 #include <ctime>
 #include <cmath>
 
@@ -126,6 +128,38 @@ void TestUtil::testSplitCompoundUnit() {
 }
 
 
+
+void TestUtil::testParseUnit() {
+    std::shared_ptr<const util::Unit> unit = util::parseUnit("mV^2*Hz^-1");
+    CPPUNIT_ASSERT(unit->isCompound());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), unit->terms.size());
+    CPPUNIT_ASSERT_EQUAL('*', unit->separators[0]);
+    CPPUNIT_ASSERT(unit->terms[0].prefix == "m" && unit->terms[0].unit == "V" && unit->terms[0].exponent == 2);
+    CPPUNIT_ASSERT(unit->terms[1].prefix == "" && unit->terms[1].unit == "Hz" && unit->terms[1].exponent == -1);
+    CPPUNIT_ASSERT(util::parseUnit("mV^2*Hz^-1") == unit);
+
+    unit = util::parseUnit("mmol^2");
+    CPPUNIT_ASSERT(unit->isAtomic());
+    CPPUNIT_ASSERT(unit->terms[0].prefix == "m" && unit->terms[0].unit == "mol" && unit->terms[0].power == "2");
+    CPPUNIT_ASSERT_EQUAL(1e-3, unit->terms[0].factor);
+
+    unit = util::parseUnit("dam");
+    CPPUNIT_ASSERT(unit->isAtomic() && unit->terms[0].prefix == "da" && unit->terms[0].unit == "m");
+
+    CPPUNIT_ASSERT(!util::parseUnit("")->isSI());
+    CPPUNIT_ASSERT(!util::parseUnit("mV/")->isSI());
+    CPPUNIT_ASSERT(!util::parseUnit("V^0")->isSI());
+    CPPUNIT_ASSERT(!util::parseUnit("min")->isSI());
+
+    // cached results
+    for (int i = 0; i < 2; i++) {
+        CPPUNIT_ASSERT(util::getSIScaling("mmol^2", "mol^2") == 1e-6);
+        CPPUNIT_ASSERT(util::getSIScaling("mV/s", "mV/s") == 1.0);
+        CPPUNIT_ASSERT_THROW(util::getSIScaling("mV/s", "V/s"), nix::InvalidUnit);
+        CPPUNIT_ASSERT_THROW(util::getSIScaling("min", "s"), nix::InvalidUnit);
+    }
+}
+
 void TestUtil::testConvertToSeconds() {
     string unit_min = "min";
     string unit_h = "h";
@@ -35,6 +35,7 @@ private:
     CPPUNIT_TEST(testIsAtomicSIUnit);
     CPPUNIT_TEST(testIsCompoundSIUnit);
     CPPUNIT_TEST(testSplitCompoundUnit);
+    CPPUNIT_TEST(testParseUnit);
     CPPUNIT_TEST(testConvertToSeconds);
     CPPUNIT_TEST(testConvertToKelvin);
     CPPUNIT_TEST(testUnitSanitizer);
@@ -49,6 +50,7 @@ public:
     void testIsAtomicSIUnit();
     void testIsCompoundSIUnit();
     void testSplitCompoundUnit();
+    void testParseUnit();
     void testPositionToIndex();
     void testConvertToSeconds();
     void testConvertToKelvin();